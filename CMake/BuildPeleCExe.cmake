@@ -100,16 +100,23 @@ function(build_pelec_exe pelec_exe_name)
        ${SRC_DIR}/LES.cpp
        ${SRC_DIR}/MOL.H
        ${SRC_DIR}/MOL.cpp
+       ${SRC_DIR}/MOLTileTuner.H
+       ${SRC_DIR}/MOLTileTuner.cpp
        ${SRC_DIR}/Particle.cpp
        ${SRC_DIR}/PeleC.H
        ${SRC_DIR}/PeleC.cpp
        ${SRC_DIR}/Problem.H
        ${SRC_DIR}/ProblemDerive.H
        ${SRC_DIR}/Riemann.H
+       ${SRC_DIR}/ScratchArena.H
+       ${SRC_DIR}/ScratchArena.cpp
        ${SRC_DIR}/Setup.cpp
        ${SRC_DIR}/Sources.cpp
+       ${SRC_DIR}/SumIQ.H
        ${SRC_DIR}/SumIQ.cpp
        ${SRC_DIR}/SumUtils.cpp
+       ${SRC_DIR}/TabulatedProfile.H
+       ${SRC_DIR}/TabulatedProfile.cpp
        ${SRC_DIR}/Tagging.H
        ${SRC_DIR}/Tagging.cpp
        ${SRC_DIR}/Timestep.H
@@ -118,7 +125,8 @@ function(build_pelec_exe pelec_exe_name)
        ${SRC_DIR}/Utilities.cpp
   )
 
-  if(NOT "${pelec_exe_name}" STREQUAL "pelec_unit_tests")
+  if(NOT "${pelec_exe_name}" STREQUAL "pelec_unit_tests" AND
+     NOT "${pelec_exe_name}" STREQUAL "pelec_kernel_bench")
     target_sources(${pelec_exe_name}
        PRIVATE
          ${SRC_DIR}/main.cpp
@@ -21,7 +21,7 @@ set(AMReX_HYPRE OFF)
 set(AMReX_FPE OFF)
 set(AMReX_ASSERTIONS OFF)
 set(AMReX_BASE_PROFILE OFF)
-set(AMReX_TINY_PROFILE OFF)
+set(AMReX_TINY_PROFILE ${PELEC_ENABLE_TINY_PROFILE})
 set(AMReX_TRACE_PROFILE OFF)
 set(AMReX_MEM_PROFILE OFF)
 set(AMReX_COMM_PROFILE OFF)
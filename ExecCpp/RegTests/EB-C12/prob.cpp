@@ -32,6 +32,11 @@ PeleC::problem_post_timestep()
 {
 }
 
+void
+PeleC::problem_pre_init_data()
+{
+}
+
 void
 PeleC::problem_post_init()
 {
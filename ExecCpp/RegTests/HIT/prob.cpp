@@ -2,7 +2,9 @@
 
 namespace ProbParm {
 std::string iname = "";
+std::string dname = "";
 AMREX_GPU_DEVICE_MANAGED bool binfmt = false;
+AMREX_GPU_DEVICE_MANAGED bool csv_cache = true;
 AMREX_GPU_DEVICE_MANAGED bool restart = false;
 AMREX_GPU_DEVICE_MANAGED amrex::Real lambda0 = 0.5;
 AMREX_GPU_DEVICE_MANAGED amrex::Real reynolds_lambda0 = 100.0;
@@ -21,42 +23,52 @@ AMREX_GPU_DEVICE_MANAGED amrex::Real tau = 0.0;
 AMREX_GPU_DEVICE_MANAGED amrex::Real p0 = 1.013e6; // [erg cm^-3]
 AMREX_GPU_DEVICE_MANAGED amrex::Real T0 = 300.0;
 AMREX_GPU_DEVICE_MANAGED amrex::Real eint0 = 0.0;
-amrex::Gpu::ManagedVector<amrex::Real>* v_xinput = nullptr;
 amrex::Gpu::ManagedVector<amrex::Real>* v_uinput = nullptr;
 amrex::Gpu::ManagedVector<amrex::Real>* v_vinput = nullptr;
 amrex::Gpu::ManagedVector<amrex::Real>* v_winput = nullptr;
 amrex::Gpu::ManagedVector<amrex::Real>* v_xarray = nullptr;
 amrex::Gpu::ManagedVector<amrex::Real>* v_xdiff = nullptr;
+amrex::Gpu::ManagedVector<int>* v_zplane = nullptr;
 
-AMREX_GPU_DEVICE_MANAGED amrex::Real* xinput = nullptr;
 AMREX_GPU_DEVICE_MANAGED amrex::Real* uinput = nullptr;
 AMREX_GPU_DEVICE_MANAGED amrex::Real* vinput = nullptr;
 AMREX_GPU_DEVICE_MANAGED amrex::Real* winput = nullptr;
 AMREX_GPU_DEVICE_MANAGED amrex::Real* xarray = nullptr;
 AMREX_GPU_DEVICE_MANAGED amrex::Real* xdiff = nullptr;
+AMREX_GPU_DEVICE_MANAGED int* zplane = nullptr;
 
 } // namespace ProbParm
 
+namespace {
+// Release the velocities read for the initial data
 void
-pc_prob_close()
+pc_free_input()
 {
-  delete ProbParm::v_xinput;
   delete ProbParm::v_uinput;
   delete ProbParm::v_vinput;
   delete ProbParm::v_winput;
-  delete ProbParm::v_xarray;
-  delete ProbParm::v_xdiff;
+  delete ProbParm::v_zplane;
 
-  ProbParm::v_xinput = nullptr;
   ProbParm::v_uinput = nullptr;
   ProbParm::v_vinput = nullptr;
   ProbParm::v_winput = nullptr;
-  ProbParm::v_xarray = nullptr;
-  ProbParm::v_xdiff = nullptr;
-  ProbParm::xinput = nullptr;
+  ProbParm::v_zplane = nullptr;
   ProbParm::uinput = nullptr;
   ProbParm::vinput = nullptr;
   ProbParm::winput = nullptr;
+  ProbParm::zplane = nullptr;
+}
+} // namespace
+
+void
+pc_prob_close()
+{
+  pc_free_input();
+  delete ProbParm::v_xarray;
+  delete ProbParm::v_xdiff;
+
+  ProbParm::v_xarray = nullptr;
+  ProbParm::v_xdiff = nullptr;
   ProbParm::xarray = nullptr;
   ProbParm::xdiff = nullptr;
 }
@@ -75,6 +87,7 @@ amrex_probinit(
   amrex::ParmParse pp("prob");
   pp.query("iname", ProbParm::iname);
   pp.query("binfmt", ProbParm::binfmt);
+  pp.query("csv_cache", ProbParm::csv_cache);
   pp.query("restart", ProbParm::restart);
   pp.query("lambda0", ProbParm::lambda0);
   pp.query("reynolds_lambda0", ProbParm::reynolds_lambda0);
@@ -134,13 +147,17 @@ amrex_probinit(
     << forcing_params::forcing << std::endl;
   ofs.close();
 
-  // Load velocity fields from file. Assume data set ordered in Fortran
-  // format and reshape the data accordingly. One thing to keep in mind
-  // is that this contains the entire input data. We will interpolate
-  // this data later to just match our box. Another assumption is that
-  // the input data is a periodic cube. If the input cube is smaller
-  // than our domain size, the cube will be repeated throughout the
-  // domain (hence the mod operations in the interpolation).
+  // Velocity fields from file. Assume data set ordered in Fortran
+  // format. Another assumption is that the input data is a periodic
+  // cube. If the input cube is smaller than our domain size, the cube
+  // will be repeated throughout the domain (hence the mod operations in
+  // the interpolation).
+  //
+  // The velocities are read at initData time, where each rank only
+  // reads the z planes needed by its boxes (problem_pre_init_data). They
+  // are read from a file in the read_binary layout: the binary input
+  // itself, or a binary copy of the csv input made here by the I/O rank.
+  // Only the x coordinates of the first row are read here.
   if (ProbParm::restart) {
     amrex::Print() << "Skipping input file reading and assuming restart."
                    << std::endl;
@@ -148,39 +165,30 @@ amrex_probinit(
     const size_t nx = ProbParm::inres;
     const size_t ny = ProbParm::inres;
     const size_t nz = ProbParm::inres;
-    amrex::Vector<double> data(nx * ny * nz * 6); /* this needs to be double */
-    if (ProbParm::binfmt) {
-      read_binary(ProbParm::iname, nx, ny, nz, 6, data);
-    } else {
-      read_csv(ProbParm::iname, nx, ny, nz, data);
+
+    const int ioproc = amrex::ParallelDescriptor::IOProcessorNumber();
+    ProbParm::dname = ProbParm::iname;
+    if (!ProbParm::binfmt) {
+      ProbParm::dname = ProbParm::iname + ".bin";
+      if (amrex::ParallelDescriptor::IOProcessor()) {
+        csv_binary_copy(ProbParm::iname, nx, ny, nz, 6, ProbParm::csv_cache);
+      }
+      amrex::ParallelDescriptor::Barrier();
     }
 
-    // Extract position and velocities
-    ProbParm::v_uinput = new amrex::Gpu::ManagedVector<amrex::Real>;
-    ProbParm::v_vinput = new amrex::Gpu::ManagedVector<amrex::Real>;
-    ProbParm::v_winput = new amrex::Gpu::ManagedVector<amrex::Real>;
     ProbParm::v_xarray = new amrex::Gpu::ManagedVector<amrex::Real>;
-    ProbParm::v_xinput = new amrex::Gpu::ManagedVector<amrex::Real>;
     ProbParm::v_xdiff = new amrex::Gpu::ManagedVector<amrex::Real>;
-    ProbParm::v_xinput->resize(nx * ny * nz);
-    ProbParm::v_uinput->resize(nx * ny * nz);
-    ProbParm::v_vinput->resize(nx * ny * nz);
-    ProbParm::v_winput->resize(nx * ny * nz);
-    for (int i = 0; i < ProbParm::v_xinput->size(); i++) {
-      (*ProbParm::v_xinput)[i] = data[0 + i * 6];
-      (*ProbParm::v_uinput)[i] =
-        data[3 + i * 6] * ProbParm::urms0 / ProbParm::uin_norm;
-      (*ProbParm::v_vinput)[i] =
-        data[4 + i * 6] * ProbParm::urms0 / ProbParm::uin_norm;
-      (*ProbParm::v_winput)[i] =
-        data[5 + i * 6] * ProbParm::urms0 / ProbParm::uin_norm;
-    }
-
-    // Get the xarray table and the differences.
     ProbParm::v_xarray->resize(nx);
-    for (int i = 0; i < ProbParm::v_xarray->size(); i++) {
-      (*ProbParm::v_xarray)[i] = (*ProbParm::v_xinput)[i];
+    if (amrex::ParallelDescriptor::IOProcessor()) {
+      amrex::Vector<double> row(nx * 6); /* this needs to be double */
+      read_binary_slab(ProbParm::dname, 0, row);
+      for (size_t i = 0; i < nx; i++) {
+        (*ProbParm::v_xarray)[i] = row[0 + i * 6];
+      }
     }
+    pc_bcast(ProbParm::v_xarray->data(), nx, ioproc);
+
+    // Get the differences of the xarray table
     ProbParm::v_xdiff->resize(nx);
     std::adjacent_difference(
       ProbParm::v_xarray->begin(), ProbParm::v_xarray->end(),
@@ -193,10 +201,6 @@ amrex_probinit(
       amrex::Abort("Error: non ascending x-coordinate array.");
 
     // Get pointer to the data
-    ProbParm::xinput = ProbParm::v_xinput->dataPtr();
-    ProbParm::uinput = ProbParm::v_uinput->dataPtr();
-    ProbParm::vinput = ProbParm::v_vinput->dataPtr();
-    ProbParm::winput = ProbParm::v_winput->dataPtr();
     ProbParm::xarray = ProbParm::v_xarray->dataPtr();
     ProbParm::xdiff = ProbParm::v_xdiff->dataPtr();
 
@@ -212,9 +216,75 @@ PeleC::problem_post_timestep()
 {
 }
 
+void
+PeleC::problem_pre_init_data()
+{
+  if (ProbParm::xarray == nullptr) {
+    amrex::Abort("prob.restart is set, but the run does not restart");
+  }
+
+  // z planes of the input needed by the local boxes of this level: the
+  // interpolation in pc_initdata uses the planes on both sides of each cell
+  const int nres = ProbParm::inres;
+  const size_t nplane = static_cast<size_t>(nres) * nres;
+  const amrex::Real* prob_lo = geom.ProbLo();
+  const amrex::Real* dx = geom.CellSize();
+  amrex::Vector<int> needed(nres, 0);
+  for (amrex::MFIter mfi(get_new_data(State_Type), false); mfi.isValid();
+       ++mfi) {
+    const amrex::Box& box = mfi.validbox();
+    for (int k = box.smallEnd(2); k <= box.bigEnd(2); k++) {
+      amrex::Real mod =
+        std::fmod(prob_lo[2] + (k + 0.5) * dx[2], ProbParm::Linput);
+      int idx = 0;
+      locate(ProbParm::xarray, nres, mod, idx);
+      needed[idx] = 1;
+      needed[(idx + 1) % nres] = 1;
+    }
+  }
+
+  pc_free_input();
+  ProbParm::v_zplane = new amrex::Gpu::ManagedVector<int>(nres, -1);
+  int nlocal = 0;
+  for (int k = 0; k < nres; k++) {
+    if (needed[k]) {
+      (*ProbParm::v_zplane)[k] = nlocal++;
+    }
+  }
+  ProbParm::v_uinput = new amrex::Gpu::ManagedVector<amrex::Real>(
+    std::max<size_t>(nlocal * nplane, 1));
+  ProbParm::v_vinput = new amrex::Gpu::ManagedVector<amrex::Real>(
+    std::max<size_t>(nlocal * nplane, 1));
+  ProbParm::v_winput = new amrex::Gpu::ManagedVector<amrex::Real>(
+    std::max<size_t>(nlocal * nplane, 1));
+
+  // Read each plane with a single offset read
+  const amrex::Real fac = ProbParm::urms0 / ProbParm::uin_norm;
+  amrex::Vector<double> data(nplane * 6); /* this needs to be double */
+  for (int k = 0; k < nres; k++) {
+    if (!needed[k]) {
+      continue;
+    }
+    read_binary_slab(ProbParm::dname, k * nplane * 6, data);
+    const size_t off = (*ProbParm::v_zplane)[k] * nplane;
+    for (size_t i = 0; i < nplane; i++) {
+      (*ProbParm::v_uinput)[off + i] = data[3 + i * 6] * fac;
+      (*ProbParm::v_vinput)[off + i] = data[4 + i * 6] * fac;
+      (*ProbParm::v_winput)[off + i] = data[5 + i * 6] * fac;
+    }
+  }
+
+  ProbParm::uinput = ProbParm::v_uinput->dataPtr();
+  ProbParm::vinput = ProbParm::v_vinput->dataPtr();
+  ProbParm::winput = ProbParm::v_winput->dataPtr();
+  ProbParm::zplane = ProbParm::v_zplane->dataPtr();
+}
+
 void
 PeleC::problem_post_init()
 {
+  // The velocities of the input are only needed by initData
+  pc_free_input();
 }
 
 void
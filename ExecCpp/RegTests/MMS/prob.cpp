@@ -323,6 +323,11 @@ PeleC::problem_post_timestep()
 #endif
 }
 
+void
+PeleC::problem_pre_init_data()
+{
+}
+
 void
 PeleC::problem_post_init()
 {
@@ -7,16 +7,12 @@ AMREX_GPU_DEVICE_MANAGED amrex::Real T_in = 298.0;
 AMREX_GPU_DEVICE_MANAGED amrex::Real vn_in = 0.2;
 AMREX_GPU_DEVICE_MANAGED amrex::Real pertmag = 0.0;
 AMREX_GPU_DEVICE_MANAGED amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> L = {1.0};
-AMREX_GPU_DEVICE_MANAGED unsigned int pmf_N = 0;
-AMREX_GPU_DEVICE_MANAGED unsigned int pmf_M = 0;
 AMREX_GPU_DEVICE_MANAGED bool pmf_do_average = false;
+AMREX_GPU_DEVICE_MANAGED TabulatedProfile pmf_table;
 
-amrex::Gpu::ManagedVector<amrex::Real>* pmf_X = nullptr;
-amrex::Gpu::ManagedVector<amrex::Real>* pmf_Y = nullptr;
+TabulatedProfileData* pmf_data = nullptr;
 amrex::Gpu::ManagedVector<amrex::Real>* fuel_state = nullptr;
 
-AMREX_GPU_DEVICE_MANAGED amrex::Real* d_pmf_X = nullptr;
-AMREX_GPU_DEVICE_MANAGED amrex::Real* d_pmf_Y = nullptr;
 AMREX_GPU_DEVICE_MANAGED amrex::Real* d_fuel_state = nullptr;
 
 std::string pmf_datafile = "";
@@ -93,25 +89,29 @@ read_pmf(const std::string myfile)
   }
   amrex::Print() << line_count << " data lines found in PMF file" << std::endl;
 
-  ProbParm::pmf_N = line_count;
-  ProbParm::pmf_M = variable_count - 1;
-  ProbParm::pmf_X->resize(ProbParm::pmf_N);
-  ProbParm::pmf_Y->resize(ProbParm::pmf_N * ProbParm::pmf_M);
+  const int pmf_N = line_count;
+  const int pmf_M = variable_count - 1;
+  if (pmf_M > NUM_SPECIES + 4)
+    amrex::Abort("PMF file has more variables than expected");
+  amrex::Vector<amrex::Real> pmf_X(pmf_N);
+  amrex::Vector<amrex::Real> pmf_Y(pmf_N * pmf_M);
 
   iss.clear();
   iss.seekg(0, std::ios::beg);
   std::getline(iss, firstline);
   std::getline(iss, secondline);
-  for (int i = 0; i < ProbParm::pmf_N; i++) {
+  for (int i = 0; i < pmf_N; i++) {
     std::getline(iss, remaininglines);
     std::istringstream sinput(remaininglines);
-    sinput >> (*ProbParm::pmf_X)[i];
-    for (int j = 0; j < ProbParm::pmf_M; j++) {
-      sinput >> (*ProbParm::pmf_Y)[j * ProbParm::pmf_N + i];
+    sinput >> pmf_X[i];
+    for (int j = 0; j < pmf_M; j++) {
+      sinput >> pmf_Y[j * pmf_N + i];
     }
   }
-  ProbParm::d_pmf_X = ProbParm::pmf_X->dataPtr();
-  ProbParm::d_pmf_Y = ProbParm::pmf_Y->dataPtr();
+  ProbParm::pmf_data->define(std::move(pmf_X), std::move(pmf_Y), pmf_M);
+  ProbParm::pmf_table = ProbParm::pmf_data->view();
+  if (ProbParm::pmf_data->uniform())
+    amrex::Print() << "PMF data is uniformly spaced" << std::endl;
 }
 
 void
@@ -166,15 +166,12 @@ init_bc()
 void
 pc_prob_close()
 {
-  delete ProbParm::pmf_X;
-  delete ProbParm::pmf_Y;
+  delete ProbParm::pmf_data;
   delete ProbParm::fuel_state;
 
-  ProbParm::pmf_X = nullptr;
-  ProbParm::pmf_Y = nullptr;
+  ProbParm::pmf_data = nullptr;
+  ProbParm::pmf_table = TabulatedProfile{0, 0, nullptr, nullptr, nullptr, 0.0};
   ProbParm::fuel_state = nullptr;
-  ProbParm::d_pmf_X = nullptr;
-  ProbParm::d_pmf_Y = nullptr;
   ProbParm::d_fuel_state = nullptr;
 }
 
@@ -194,13 +191,13 @@ amrex_probinit(
   pp.query("vn_in", ProbParm::vn_in);
   pp.query("pertmag", ProbParm::pertmag);
   pp.query("pmf_datafile", ProbParm::pmf_datafile);
+  pp.query("pmf_do_average", ProbParm::pmf_do_average);
 
   ProbParm::L[0] = probhi[0] - problo[0];
   ProbParm::L[1] = probhi[1] - problo[1];
   ProbParm::L[2] = probhi[2] - problo[2];
 
-  ProbParm::pmf_X = new amrex::Gpu::ManagedVector<amrex::Real>;
-  ProbParm::pmf_Y = new amrex::Gpu::ManagedVector<amrex::Real>;
+  ProbParm::pmf_data = new TabulatedProfileData;
   ProbParm::fuel_state = new amrex::Gpu::ManagedVector<amrex::Real>;
   ProbParm::fuel_state->resize(NVAR);
 
@@ -215,6 +212,11 @@ PeleC::problem_post_timestep()
 {
 }
 
+void
+PeleC::problem_pre_init_data()
+{
+}
+
 void
 PeleC::problem_post_init()
 {
@@ -0,0 +1,890 @@
+/** \file kernel-bench.cpp
+ *  Microbenchmark of the hot physics kernels on synthetic boxes
+ *
+ *  Each kernel is run on every tile of a periodic box of bench.ncell^DIM
+ *  cells filled with a smooth multi-species state. The cells per second and
+ *  the bytes per cell moved through the fabs given to the kernel are reported
+ *  and written as JSON, which can be compared against a stored baseline.
+ */
+
+#include <fstream>
+#include <map>
+#include <string>
+
+#include <AMReX.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_iMultiFab.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_BoxIterator.H>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include "Constants.H"
+#include "IndexDefines.H"
+#include "EOS.H"
+#include "Transport.H"
+#include "Utilities.H"
+#include "Godunov.H"
+#include "MOL.H"
+#include "Diffterm.H"
+#include "Filter.H"
+#include "ScratchArena.H"
+#ifdef PELEC_USE_REACTIONS
+#include "React.H"
+#endif
+#ifdef PELEC_USE_EB
+#include "EB.H"
+#endif
+
+// Necessary as it's used in other source files
+std::string inputs_name = "";
+
+namespace {
+// Synthetic data shared by all the kernels
+struct BenchData
+{
+  amrex::Geometry geom;
+  amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx;
+  amrex::MultiFab S;
+  amrex::MultiFab Q;
+  amrex::MultiFab Qaux;
+  amrex::MultiFab srcQ;
+  amrex::MultiFab nr_src;
+  amrex::MultiFab coeff;
+  amrex::MultiFab vol;
+  amrex::MultiFab area[AMREX_SPACEDIM];
+  amrex::Real dt = 1.0e-7;
+  int ppm_type = 0;
+  int use_flattening = 1;
+  int plm_iorder = 2;
+  int riemann_solver = 0;
+  int do_harmonic = 1;
+  int nsteps_min = 20;
+  int nsteps_max = 300;
+  int nsteps_guess = 50;
+  amrex::Real errtol = 1e-16;
+  Filter filter;
+#ifdef PELEC_USE_EB
+  // Planes of cut cells every eb_spacing cells along z
+  int eb_spacing = 8;
+  amrex::Real eb_small_vfrac = 1.0e-2;
+  amrex::FabArray<amrex::EBCellFlagFab> flags;
+  amrex::MultiFab vfrac;
+  amrex::MultiFab flux[AMREX_SPACEDIM];
+  amrex::iMultiFab level_mask;
+  amrex::Vector<amrex::Gpu::DeviceVector<EBBndryGeom>> ebg;
+  amrex::Vector<amrex::Gpu::DeviceVector<EBRedistSten>> sten;
+#endif
+};
+
+// Work done by a kernel on one tile
+struct KernelCost
+{
+  long cells = 0;
+  amrex::Real bytes = 0.0;
+};
+
+using BenchKernel = KernelCost (*)(const amrex::MFIter&, BenchData&);
+
+struct BenchResult
+{
+  std::string name;
+  long cells = 0;
+  amrex::Real seconds = 0.0;
+  amrex::Real bytes = 0.0;
+};
+
+// Bytes of ncomp components over bx
+amrex::Real
+fab_bytes(const amrex::Box& bx, const int ncomp)
+{
+  return static_cast<amrex::Real>(bx.numPts()) * ncomp * sizeof(amrex::Real);
+}
+
+#ifdef PELEC_USE_EB
+AMREX_GPU_HOST_DEVICE
+AMREX_FORCE_INLINE
+bool
+is_cut_plane(const int k, const int spacing)
+{
+  return ((k % spacing) + spacing) % spacing == spacing / 2;
+}
+#endif
+
+// Premixed-like state with smooth temperature and velocity variations
+void
+fill_state(
+  const amrex::Box& gbx,
+  const amrex::Array4<amrex::Real>& s,
+  const amrex::GeometryData& geomdata)
+{
+  amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    const amrex::Real* prob_lo = geomdata.ProbLo();
+    const amrex::Real* dx = geomdata.CellSize();
+    const amrex::Real x = prob_lo[0] + (i + 0.5) * dx[0];
+    const amrex::Real y =
+      AMREX_SPACEDIM > 1 ? prob_lo[1] + (j + 0.5) * dx[1] : 0.0;
+    const amrex::Real z =
+      AMREX_SPACEDIM > 2 ? prob_lo[2] + (k + 0.5) * dx[2] : 0.0;
+    amrex::Real massfrac[NUM_SPECIES];
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      massfrac[n] = 1.0 / NUM_SPECIES;
+    }
+    const amrex::Real p = 1.01325e6;
+    const amrex::Real T =
+      1200.0 + 300.0 * std::sin(2.0 * PI * x) * std::cos(2.0 * PI * (y + z));
+    const amrex::Real u = 1.0e3 * std::sin(2.0 * PI * y);
+    const amrex::Real v = 1.0e3 * std::sin(2.0 * PI * z);
+    const amrex::Real w = 1.0e3 * std::sin(2.0 * PI * x);
+    amrex::Real rho, eint;
+    EOS::PYT2RE(p, massfrac, T, rho, eint);
+    for (int n = 0; n < NVAR; n++) {
+      s(i, j, k, n) = 0.0;
+    }
+    s(i, j, k, URHO) = rho;
+    s(i, j, k, UMX) = rho * u;
+    s(i, j, k, UMY) = rho * v;
+    s(i, j, k, UMZ) = rho * w;
+    s(i, j, k, UEINT) = rho * eint;
+    s(i, j, k, UEDEN) = rho * (eint + 0.5 * (u * u + v * v + w * w));
+    s(i, j, k, UTEMP) = T;
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      s(i, j, k, UFS + n) = rho * massfrac[n];
+    }
+  });
+}
+
+void
+fill_primitives(
+  const amrex::Box& gbx,
+  const amrex::Array4<const amrex::Real>& s,
+  const amrex::Array4<amrex::Real>& q,
+  const amrex::Array4<amrex::Real>& qa)
+{
+  amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    pc_ctoprim(i, j, k, s, q, qa);
+  });
+}
+
+void
+fill_transport_coeffs(
+  const amrex::Box& gbx,
+  const amrex::FArrayBox& q,
+  amrex::FArrayBox& coeff)
+{
+  auto const& Y = q.const_array(QFS);
+  auto const& T = q.const_array(QTEMP);
+  auto const& rho = q.const_array(QRHO);
+  auto const& rhoD = coeff.array(dComp_rhoD);
+  auto const& mu = coeff.array(dComp_mu);
+  auto const& xi = coeff.array(dComp_xi);
+  auto const& lambda = coeff.array(dComp_lambda);
+  amrex::launch(gbx, [=] AMREX_GPU_DEVICE(amrex::Box const& tbx) {
+    get_transport_coeffs(tbx, Y, T, rho, rhoD, mu, xi, lambda);
+  });
+}
+
+#ifdef PELEC_USE_EB
+// Single-valued cells of volume fraction 1/2 on the cut planes
+void
+fill_synthetic_eb(
+  const amrex::Box& gbx,
+  const int spacing,
+  const amrex::Array4<amrex::EBCellFlag>& fl,
+  const amrex::Array4<amrex::Real>& vf)
+{
+  amrex::ParallelFor(gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    amrex::EBCellFlag flag = amrex::EBCellFlag::TheDefaultCell();
+    const bool cut = is_cut_plane(k, spacing);
+    if (cut) {
+      flag.setSingleValued();
+    } else {
+      flag.setRegular();
+    }
+    fl(i, j, k) = flag;
+    vf(i, j, k) = cut ? 0.5 : 1.0;
+  });
+}
+#endif
+
+void
+setup(BenchData& d, const int ncell, const int max_grid_size)
+{
+  const amrex::Box domain(
+    amrex::IntVect(AMREX_D_DECL(0, 0, 0)),
+    amrex::IntVect(AMREX_D_DECL(ncell - 1, ncell - 1, ncell - 1)));
+  const amrex::RealBox real_box(
+    {AMREX_D_DECL(0.0, 0.0, 0.0)}, {AMREX_D_DECL(1.0, 1.0, 1.0)});
+  const amrex::Array<int, AMREX_SPACEDIM> is_periodic{AMREX_D_DECL(1, 1, 1)};
+  d.geom.define(domain, real_box, amrex::CoordSys::cartesian, is_periodic);
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    d.dx[dir] = d.geom.CellSize()[dir];
+  }
+
+  amrex::BoxArray ba(domain);
+  ba.maxSize(max_grid_size);
+  const amrex::DistributionMapping dm(ba);
+  const int ng = NUM_GROW;
+  const int nCompTr = dComp_lambda + 1;
+
+  d.S.define(ba, dm, NVAR, ng);
+  d.Q.define(ba, dm, QVAR, ng);
+  d.Qaux.define(ba, dm, NQAUX, ng);
+  d.srcQ.define(ba, dm, QVAR, ng);
+  d.nr_src.define(ba, dm, NVAR, ng);
+  d.coeff.define(ba, dm, nCompTr, ng);
+  d.vol.define(ba, dm, 1, ng);
+  d.srcQ.setVal(0.0);
+  d.nr_src.setVal(0.0);
+
+  amrex::Real cell_vol = 1.0;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    cell_vol *= d.dx[dir];
+  }
+  d.vol.setVal(cell_vol);
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    d.area[dir].define(
+      amrex::convert(ba, amrex::IntVect::TheDimensionVector(dir)), dm, 1, ng);
+    d.area[dir].setVal(cell_vol / d.dx[dir]);
+  }
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(d.S, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
+    const amrex::Box gbx = mfi.growntilebox();
+    fill_state(gbx, d.S.array(mfi), d.geom.data());
+    fill_primitives(
+      gbx, d.S.const_array(mfi), d.Q.array(mfi), d.Qaux.array(mfi));
+    fill_transport_coeffs(gbx, d.Q[mfi], d.coeff[mfi]);
+  }
+
+#ifdef PELEC_USE_EB
+  d.flags.define(ba, dm, 1, ng);
+  d.vfrac.define(ba, dm, 1, ng);
+  d.level_mask.define(ba, dm, 1, ng);
+  d.level_mask.setVal(1);
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    d.flux[dir].define(
+      amrex::convert(ba, amrex::IntVect::TheDimensionVector(dir)), dm, NVAR,
+      ng);
+    d.flux[dir].setVal(1.0);
+  }
+  d.ebg.resize(d.vfrac.local_size());
+  d.sten.resize(d.vfrac.local_size());
+  for (amrex::MFIter mfi(d.vfrac, false); mfi.isValid(); ++mfi) {
+    const amrex::Box gbx = mfi.fabbox();
+    fill_synthetic_eb(
+      gbx, d.eb_spacing, d.flags.array(mfi), d.vfrac.array(mfi));
+
+    amrex::Vector<EBBndryGeom> h_ebg;
+    for (amrex::BoxIterator bit(gbx); bit.ok(); ++bit) {
+      if (is_cut_plane(bit()[2], d.eb_spacing)) {
+        EBBndryGeom g;
+        for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+          g.eb_normal[dir] = dir == AMREX_SPACEDIM - 1 ? 1.0 : 0.0;
+          g.eb_centroid[dir] = 0.0;
+        }
+        g.eb_area = 1.0;
+        g.eb_vfrac = 0.5;
+        g.iv = bit();
+        h_ebg.push_back(g);
+      }
+    }
+    const int iLocal = mfi.LocalIndex();
+    const int Ncut = h_ebg.size();
+    d.ebg[iLocal].resize(Ncut);
+    amrex::Gpu::copy(
+      amrex::Gpu::hostToDevice, h_ebg.begin(), h_ebg.end(),
+      d.ebg[iLocal].begin());
+    d.sten[iLocal].resize(Ncut);
+    pc_fill_redist_stencil(
+      gbx, Ncut, d.ebg[iLocal].data(), d.flags.const_array(mfi),
+      d.vfrac.const_array(mfi), d.eb_small_vfrac, d.sten[iLocal].data());
+  }
+#endif
+  amrex::Gpu::synchronize();
+}
+
+#ifdef PELEC_USE_EB
+// Thread-local accumulator of the fluxes through the cut cells of a box, as
+// given to the EB kernels by getMOLSrcTerm
+amrex::FArrayBox
+eb_flux_fab(const int Ncut)
+{
+  const amrex::Box ebox(
+    amrex::IntVect::TheZeroVector(),
+    amrex::IntVect(AMREX_D_DECL(amrex::max(Ncut, 1) - 1, 0, 0)));
+  amrex::FArrayBox fab = ScratchArena::get().fab(ebox, NVAR);
+  fab.setVal<amrex::RunOn::Device>(0.0);
+  return fab;
+}
+#endif
+
+KernelCost
+bench_hyp_mol_flux(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  ScratchArena& scratch = ScratchArena::get();
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  cost.bytes = fab_bytes(bx, QVAR + NQAUX);
+
+  amrex::FArrayBox flux_ec[AMREX_SPACEDIM];
+  amrex::Elixir flux_eli[AMREX_SPACEDIM];
+  amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    const amrex::Box ebx = amrex::surroundingNodes(bx, dir);
+    flux_ec[dir] = scratch.fab(ebx, NVAR);
+    flux_eli[dir] = flux_ec[dir].elixir();
+    flx[dir] = flux_ec[dir].array();
+    cost.bytes += fab_bytes(ebx, NVAR + 1);
+  }
+  const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
+    a{AMREX_D_DECL(
+      d.area[0].const_array(mfi), d.area[1].const_array(mfi),
+      d.area[2].const_array(mfi))};
+
+#ifdef PELEC_USE_EB
+  const int iLocal = mfi.LocalIndex();
+  const int Ncut = d.ebg[iLocal].size();
+  amrex::FArrayBox ebflux = eb_flux_fab(Ncut);
+  amrex::Elixir ebflux_eli = ebflux.elixir();
+  cost.bytes += fab_bytes(bx, 1);
+#endif
+  pc_compute_hyp_mol_flux(
+    bx, d.Q.const_array(mfi), d.Qaux.const_array(mfi), flx, a, d.dx,
+    d.plm_iorder, d.riemann_solver
+#ifdef PELEC_USE_EB
+    ,
+    d.eb_small_vfrac, d.vfrac.const_array(mfi), d.flags.const_array(mfi),
+    d.ebg[iLocal].data(), Ncut, ebflux.dataPtr(), Ncut
+#endif
+  );
+  return cost;
+}
+
+// Exact Riemann solver on the x faces, with the cell states on both sides
+KernelCost
+bench_riemann(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  const amrex::Box fbx = amrex::surroundingNodes(bx, 0);
+  ScratchArena& scratch = ScratchArena::get();
+  amrex::FArrayBox flux = scratch.fab(fbx, NVAR);
+  amrex::FArrayBox qint = scratch.fab(fbx, NGDNV);
+  amrex::Elixir flux_eli = flux.elixir();
+  amrex::Elixir qint_eli = qint.elixir();
+  auto const& q = d.Q.const_array(mfi);
+  auto const& qa = d.Qaux.const_array(mfi);
+  auto const& flx = flux.array();
+  auto const& qi = qint.array();
+
+  amrex::ParallelFor(fbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    amrex::Real spl[NUM_SPECIES];
+    amrex::Real spr[NUM_SPECIES];
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      spl[n] = q(i - 1, j, k, QFS + n);
+      spr[n] = q(i, j, k, QFS + n);
+    }
+    amrex::Real csl, csr, ustar;
+    EOS::RPY2Cs(q(i - 1, j, k, QRHO), q(i - 1, j, k, QPRES), spl, csl);
+    EOS::RPY2Cs(q(i, j, k, QRHO), q(i, j, k, QPRES), spr, csr);
+    const amrex::Real cav = 0.5 * (qa(i, j, k, QC) + qa(i - 1, j, k, QC));
+    riemann(
+      q(i - 1, j, k, QRHO), q(i - 1, j, k, QU), q(i - 1, j, k, QV),
+      q(i - 1, j, k, QW), q(i - 1, j, k, QPRES), q(i - 1, j, k, QREINT), spl,
+      qa(i - 1, j, k, QGAMC), csl, q(i, j, k, QRHO), q(i, j, k, QU),
+      q(i, j, k, QV), q(i, j, k, QW), q(i, j, k, QPRES), q(i, j, k, QREINT),
+      spr, qa(i, j, k, QGAMC), csr, 1, qa(i, j, k, QCSML), cav, ustar,
+      flx(i, j, k, URHO), flx(i, j, k, UMX), flx(i, j, k, UMY),
+      flx(i, j, k, UMZ), flx(i, j, k, UEDEN), flx(i, j, k, UEINT),
+      qi(i, j, k, GDU), qi(i, j, k, GDV), qi(i, j, k, GDW), qi(i, j, k, GDPRES),
+      qi(i, j, k, GDGAME));
+  });
+
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  // Six fluxes and five interface values are written per face
+  cost.bytes = fab_bytes(bx, QVAR + NQAUX) + fab_bytes(fbx, 11);
+  return cost;
+}
+
+// Unsplit Godunov predictor and fluxes of pc_umdrv
+KernelCost
+bench_umeth(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  const amrex::Box bxg2 = amrex::grow(bx, 2);
+  ScratchArena& scratch = ScratchArena::get();
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  cost.bytes = fab_bytes(bx, 2 * QVAR + NQAUX + 2);
+
+  amrex::FArrayBox flux_ec[AMREX_SPACEDIM];
+  amrex::FArrayBox qec[AMREX_SPACEDIM];
+  amrex::Elixir flux_eli[AMREX_SPACEDIM];
+  amrex::Elixir qec_eli[AMREX_SPACEDIM];
+  amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx;
+  amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> qe;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    const amrex::Box fbx = amrex::surroundingNodes(bx, dir);
+    const amrex::Box ebx = amrex::surroundingNodes(bxg2, dir);
+    flux_ec[dir] = scratch.fab(fbx, NVAR);
+    flux_eli[dir] = flux_ec[dir].elixir();
+    flx[dir] = flux_ec[dir].array();
+    qec[dir] = scratch.fab(ebx, NGDNV);
+    qec_eli[dir] = qec[dir].elixir();
+    qe[dir] = qec[dir].array();
+    cost.bytes += fab_bytes(fbx, NVAR + 1) + fab_bytes(ebx, NGDNV);
+  }
+  amrex::FArrayBox pdivu = scratch.fab(bx, 1);
+  amrex::Elixir pdivu_eli = pdivu.elixir();
+
+  // Periodic domain: no outflow faces
+  const int bclo[AMREX_SPACEDIM] = {AMREX_D_DECL(0, 0, 0)};
+  const int bchi[AMREX_SPACEDIM] = {AMREX_D_DECL(0, 0, 0)};
+  const int* domlo = d.geom.Domain().loVect();
+  const int* domhi = d.geom.Domain().hiVect();
+#if AMREX_SPACEDIM == 2
+  pc_umeth_2D(
+    bx, bclo, bchi, domlo, domhi, d.Q.const_array(mfi),
+    d.Qaux.const_array(mfi), d.srcQ.const_array(mfi), flx[0], flx[1], qe[0],
+    qe[1], d.area[0].const_array(mfi), d.area[1].const_array(mfi),
+    pdivu.array(), d.vol.const_array(mfi), d.dx.data(), d.dt, d.ppm_type,
+    d.use_flattening, d.riemann_solver);
+#elif AMREX_SPACEDIM == 3
+  pc_umeth_3D(
+    bx, bclo, bchi, domlo, domhi, d.Q.const_array(mfi),
+    d.Qaux.const_array(mfi), d.srcQ.const_array(mfi), flx[0], flx[1], flx[2],
+    qe[0], qe[1], qe[2], d.area[0].const_array(mfi),
+    d.area[1].const_array(mfi), d.area[2].const_array(mfi), pdivu.array(),
+    d.vol.const_array(mfi), d.dx.data(), d.dt, d.ppm_type, d.use_flattening,
+    d.riemann_solver);
+#endif
+  return cost;
+}
+
+#ifdef PELEC_USE_REACTIONS
+// Explicit chemistry integration, without updating the state
+KernelCost
+bench_expl_reactions(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  amrex::FArrayBox react_src = ScratchArena::get().fab(bx, NUM_SPECIES + 1);
+  amrex::Elixir react_src_eli = react_src.elixir();
+  auto const& sold = d.S.const_array(mfi);
+  auto const& snew = d.S.array(mfi);
+  auto const& nonrs = d.nr_src.const_array(mfi);
+  auto const& I_R = react_src.array();
+  const amrex::Real dt = d.dt;
+  const int nsteps_min = d.nsteps_min;
+  const int nsteps_max = d.nsteps_max;
+  const int nsteps_guess = d.nsteps_guess;
+  const amrex::Real errtol = d.errtol;
+  amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    pc_expl_reactions(
+      i, j, k, sold, snew, nonrs, I_R, dt, nsteps_min, nsteps_max,
+      nsteps_guess, errtol, 0);
+  });
+
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  cost.bytes = fab_bytes(bx, 2 * NVAR + NUM_SPECIES + 1);
+  return cost;
+}
+#endif
+
+KernelCost
+bench_transport_coeffs(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  fill_transport_coeffs(bx, d.Q[mfi], d.coeff[mfi]);
+
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  cost.bytes = fab_bytes(bx, NUM_SPECIES + 2 + dComp_lambda + 1);
+  return cost;
+}
+
+KernelCost
+bench_diffusion_flux(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  ScratchArena& scratch = ScratchArena::get();
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  cost.bytes = fab_bytes(bx, QVAR + dComp_lambda + 1);
+
+  amrex::FArrayBox flux_ec[AMREX_SPACEDIM];
+  amrex::Elixir flux_eli[AMREX_SPACEDIM];
+  amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    const amrex::Box ebx = amrex::surroundingNodes(bx, dir);
+    flux_ec[dir] = scratch.fab(ebx, NVAR);
+    flux_eli[dir] = flux_ec[dir].elixir();
+    flx[dir] = flux_ec[dir].array();
+    setV(ebx, NVAR, flx[dir], 0);
+    cost.bytes += fab_bytes(ebx, 2 * NVAR + 1);
+  }
+  const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
+    a{AMREX_D_DECL(
+      d.area[0].const_array(mfi), d.area[1].const_array(mfi),
+      d.area[2].const_array(mfi))};
+
+  pc_compute_diffusion_flux(
+    bx, d.Q.const_array(mfi), d.coeff.const_array(mfi), flx, a, d.dx,
+    d.do_harmonic
+#ifdef PELEC_USE_EB
+    ,
+    d.flags[mfi].getType(bx), d.ebg[mfi.LocalIndex()].size(),
+    d.ebg[mfi.LocalIndex()].data(), d.flags.const_array(mfi)
+#endif
+  );
+  return cost;
+}
+
+KernelCost
+bench_filter(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  amrex::FArrayBox filtered = ScratchArena::get().fab(bx, NVAR);
+  amrex::Elixir filtered_eli = filtered.elixir();
+  d.filter.apply_filter(bx, d.S[mfi], filtered, 0, NVAR);
+
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  cost.bytes = fab_bytes(bx, 2 * NVAR);
+  return cost;
+}
+
+#ifdef PELEC_USE_EB
+// Flux divergence and redistribution around the cut cells of the tile. As in
+// getMOLSrcTerm, the divergence lives on the tile grown by NUM_GROW - 1 since
+// it is computed and redistributed up to 2 cells outside of the tile.
+KernelCost
+bench_fix_div(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  const amrex::Box cbox = amrex::grow(bx, NUM_GROW - 1);
+  const int iLocal = mfi.LocalIndex();
+  const int Ncut = d.ebg[iLocal].size();
+  ScratchArena& scratch = ScratchArena::get();
+  amrex::FArrayBox ebflux = eb_flux_fab(Ncut);
+  amrex::FArrayBox Dterm = scratch.fab(cbox, NVAR);
+  amrex::Elixir ebflux_eli = ebflux.elixir();
+  amrex::Elixir Dterm_eli = Dterm.elixir();
+  Dterm.setVal<amrex::RunOn::Device>(0.0);
+
+  // Single level: no flux register data
+  amrex::FArrayBox dm_as_fine(amrex::Box::TheUnitBox(), NVAR);
+  amrex::FArrayBox drho_as_crse(amrex::Box::TheUnitBox(), NVAR);
+  amrex::IArrayBox rrflag_as_crse(amrex::Box::TheUnitBox());
+  amrex::Elixir dm_as_fine_eli = dm_as_fine.elixir();
+  amrex::Elixir drho_as_crse_eli = drho_as_crse.elixir();
+  amrex::Elixir rrflag_as_crse_eli = rrflag_as_crse.elixir();
+
+  // Cut cells within 2 cells of the tile, as built in getMOLSrcTerm
+  const amrex::Box rbx = amrex::grow(bx, 2);
+  const EBBndryGeom* ebg = d.ebg[iLocal].data();
+  amrex::Gpu::DeviceVector<int> v_tile_cut;
+  const int Ntile = pc_compact_index(
+    Ncut, v_tile_cut, [=] AMREX_GPU_DEVICE(int icut) noexcept {
+      return rbx.contains(ebg[icut].iv);
+    });
+
+  amrex::Real vol = 1.0;
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    vol *= d.dx[dir];
+  }
+  pc_fix_div_and_redistribute(
+    bx, vol, d.dt, NVAR, d.eb_small_vfrac, true, ebg, d.sten[iLocal].data(),
+    Ncut, v_tile_cut.data(), Ntile, d.flags.const_array(mfi),
+    AMREX_D_DECL(
+      d.flux[0].const_array(mfi), d.flux[1].const_array(mfi),
+      d.flux[2].const_array(mfi)),
+    ebflux.dataPtr(), Ncut, d.vfrac.const_array(mfi), false, false,
+    d.level_mask.const_array(mfi), rrflag_as_crse.const_array(),
+    Dterm.array(), drho_as_crse.array(), dm_as_fine.array());
+
+  // Per cut cell within 2 cells of the tile: geometry, weights, face and
+  // boundary fluxes, and the divergence over its 3^DIM neighborhood
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  const int nreal = (2 * AMREX_SPACEDIM + 1 + 2 * 27) * NVAR;
+  cost.bytes = static_cast<amrex::Real>(Ntile) *
+               (sizeof(EBBndryGeom) + sizeof(EBRedistSten) +
+                nreal * sizeof(amrex::Real));
+  return cost;
+}
+#endif
+
+// Temperature from the internal energy, starting from a guess 5% off
+KernelCost
+bench_cmpTemp(const amrex::MFIter& mfi, BenchData& d)
+{
+  const amrex::Box bx = mfi.tilebox();
+  amrex::FArrayBox state = ScratchArena::get().fab(bx, NVAR);
+  amrex::Elixir state_eli = state.elixir();
+  auto const& s = d.S.const_array(mfi);
+  auto const& sw = state.array();
+  amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    for (int n = 0; n < NVAR; n++) {
+      sw(i, j, k, n) = s(i, j, k, n);
+    }
+    sw(i, j, k, UTEMP) *= 1.05;
+    pc_cmpTemp(i, j, k, sw);
+  });
+
+  KernelCost cost;
+  cost.cells = bx.numPts();
+  cost.bytes = fab_bytes(bx, 2 * NVAR);
+  return cost;
+}
+
+struct BenchEntry
+{
+  const char* name;
+  BenchKernel fn;
+};
+
+const BenchEntry bench_kernels[] = {
+  {"pc_compute_hyp_mol_flux", bench_hyp_mol_flux},
+  {"riemann", bench_riemann},
+#if AMREX_SPACEDIM == 2
+  {"pc_umeth_2D", bench_umeth},
+#elif AMREX_SPACEDIM == 3
+  {"pc_umeth_3D", bench_umeth},
+#endif
+#ifdef PELEC_USE_REACTIONS
+  {"pc_expl_reactions", bench_expl_reactions},
+#endif
+  {"get_transport_coeffs", bench_transport_coeffs},
+  {"pc_compute_diffusion_flux", bench_diffusion_flux},
+  {"Filter::apply_filter", bench_filter},
+#ifdef PELEC_USE_EB
+  {"pc_fix_div_and_redistribute", bench_fix_div},
+#endif
+  {"pc_cmpTemp", bench_cmpTemp}};
+
+// One warm-up sweep over the tiles, then the mean of nrep timed sweeps
+BenchResult
+run_kernel(const BenchEntry& entry, BenchData& d, const int nrep)
+{
+  BenchResult result;
+  result.name = entry.name;
+  for (int rep = -1; rep < nrep; rep++) {
+    amrex::Gpu::synchronize();
+    amrex::ParallelDescriptor::Barrier();
+    const amrex::Real t0 = amrex::second();
+    long cells = 0;
+    amrex::Real bytes = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())                     \
+  reduction(+ : cells, bytes)
+#endif
+    for (amrex::MFIter mfi(d.S, amrex::TilingIfNotGPU()); mfi.isValid();
+         ++mfi) {
+      const KernelCost cost = entry.fn(mfi, d);
+      cells += cost.cells;
+      bytes += cost.bytes;
+      ScratchArena::get().reset();
+    }
+    amrex::Gpu::synchronize();
+    amrex::Real seconds = amrex::second() - t0;
+    amrex::ParallelDescriptor::ReduceRealMax(seconds);
+    if (rep >= 0) {
+      result.seconds += seconds / nrep;
+      result.cells = cells;
+      result.bytes = bytes;
+    }
+  }
+  amrex::ParallelDescriptor::ReduceLongSum(result.cells);
+  amrex::ParallelDescriptor::ReduceRealSum(result.bytes);
+  return result;
+}
+
+// Cells per second of each kernel in a JSON file written by this program
+std::map<std::string, amrex::Real>
+read_baseline(const std::string& fname)
+{
+  std::map<std::string, amrex::Real> baseline;
+  std::ifstream ifs(fname);
+  if (!ifs.good()) {
+    amrex::FileOpenFailed(fname);
+  }
+  const std::string name_key = "\"name\": \"";
+  const std::string cps_key = "\"cells_per_second\": ";
+  std::string line;
+  while (std::getline(ifs, line)) {
+    const auto in = line.find(name_key);
+    const auto ic = line.find(cps_key);
+    if (in == std::string::npos || ic == std::string::npos) {
+      continue;
+    }
+    const auto start = in + name_key.size();
+    const std::string name = line.substr(start, line.find('"', start) - start);
+    baseline[name] = std::stod(line.substr(ic + cps_key.size()));
+  }
+  return baseline;
+}
+
+void
+write_json(
+  const std::string& fname,
+  const amrex::Vector<BenchResult>& results,
+  const int ncell,
+  const int max_grid_size)
+{
+  int nthreads = 1;
+#ifdef _OPENMP
+  nthreads = omp_get_max_threads();
+#endif
+  std::ofstream ofs(fname);
+  if (!ofs.good()) {
+    amrex::FileOpenFailed(fname);
+  }
+  ofs << "{\n"
+      << "  \"config\": {\"ncell\": " << ncell
+      << ", \"max_grid_size\": " << max_grid_size
+      << ", \"dim\": " << AMREX_SPACEDIM
+      << ", \"num_species\": " << NUM_SPECIES << ", \"nvar\": " << NVAR
+      << ", \"nranks\": " << amrex::ParallelDescriptor::NProcs()
+      << ", \"nthreads\": " << nthreads << "},\n"
+      << "  \"kernels\": [\n";
+  ofs.precision(6);
+  for (int n = 0; n < results.size(); n++) {
+    const BenchResult& r = results[n];
+    ofs << "    {\"name\": \"" << r.name << "\", \"cells\": " << r.cells
+        << ", \"seconds\": " << r.seconds
+        << ", \"cells_per_second\": " << r.cells / r.seconds
+        << ", \"bytes_per_cell\": " << r.bytes / r.cells << "}"
+        << (n + 1 < results.size() ? "," : "") << "\n";
+  }
+  ofs << "  ]\n}\n";
+}
+} // namespace
+
+int
+main(int argc, char** argv)
+{
+  amrex::Initialize(argc, argv);
+  int status = 0;
+  {
+    BenchData d;
+    int ncell = 64;
+    int max_grid_size = 32;
+    int nrep = 5;
+    amrex::Vector<std::string> kernels;
+    std::string output = "kernel_bench.json";
+    std::string baseline;
+    amrex::Real tolerance = 0.1;
+    {
+      amrex::ParmParse pp("bench");
+      pp.query("ncell", ncell);
+      pp.query("max_grid_size", max_grid_size);
+      pp.query("nrep", nrep);
+      pp.queryarr("kernels", kernels);
+      pp.query("output", output);
+      pp.query("baseline", baseline);
+      pp.query("tolerance", tolerance);
+      pp.query("dt", d.dt);
+#ifdef PELEC_USE_EB
+      pp.query("eb_spacing", d.eb_spacing);
+#endif
+    }
+    // Kernel options as given to PeleC
+    int les_filter_type = box;
+    int les_filter_fgr = 2;
+    {
+      amrex::ParmParse pp("pelec");
+      pp.query("ppm_type", d.ppm_type);
+      pp.query("use_flattening", d.use_flattening);
+      pp.query("plm_iorder", d.plm_iorder);
+      pp.query("riemann_solver", d.riemann_solver);
+      pp.query("do_harmonic", d.do_harmonic);
+      pp.query("adaptrk_nsubsteps_min", d.nsteps_min);
+      pp.query("adaptrk_nsubsteps_max", d.nsteps_max);
+      pp.query("adaptrk_nsubsteps_guess", d.nsteps_guess);
+      pp.query("adaptrk_errtol", d.errtol);
+      pp.query("les_filter_type", les_filter_type);
+      pp.query("les_filter_fgr", les_filter_fgr);
+#ifdef PELEC_USE_EB
+      pp.query("eb_small_vfrac", d.eb_small_vfrac);
+#endif
+    }
+    nrep = amrex::max(nrep, 1);
+
+    EOS::init();
+    transport_init();
+    indxmap::init();
+
+    d.filter = Filter(les_filter_type, les_filter_fgr);
+    if (d.filter.get_filter_ngrow() > NUM_GROW) {
+      amrex::Abort("kernel bench: filter width exceeds the ghost cells");
+    }
+    setup(d, ncell, max_grid_size);
+
+    amrex::Vector<const BenchEntry*> selected;
+    if (kernels.empty()) {
+      for (const auto& entry : bench_kernels) {
+        selected.push_back(&entry);
+      }
+    }
+    for (const auto& name : kernels) {
+      const BenchEntry* found = nullptr;
+      for (const auto& entry : bench_kernels) {
+        if (name == entry.name) {
+          found = &entry;
+        }
+      }
+      if (found == nullptr) {
+        amrex::Abort("kernel bench: unknown or unavailable kernel " + name);
+      }
+      selected.push_back(found);
+    }
+
+    amrex::Print() << "Kernel bench: " << ncell << "^" << AMREX_SPACEDIM
+                   << " cells, max_grid_size " << max_grid_size << ", "
+                   << NUM_SPECIES << " species, " << nrep << " repetitions\n";
+    amrex::Vector<BenchResult> results;
+    for (const auto* entry : selected) {
+      results.push_back(run_kernel(*entry, d, nrep));
+      const BenchResult& r = results.back();
+      amrex::Print() << "  " << r.name << ": " << r.cells / r.seconds
+                     << " cells/s, " << r.bytes / r.cells << " bytes/cell\n";
+    }
+
+    if (amrex::ParallelDescriptor::IOProcessor()) {
+      write_json(output, results, ncell, max_grid_size);
+    }
+
+    // Fail when a kernel is slower than the baseline by more than tolerance
+    if (!baseline.empty()) {
+      const auto base = read_baseline(baseline);
+      for (const auto& r : results) {
+        const auto it = base.find(r.name);
+        if (it == base.end()) {
+          amrex::Print() << "  " << r.name << ": not in the baseline\n";
+          continue;
+        }
+        const amrex::Real ratio = r.cells / r.seconds / it->second;
+        const bool slow = ratio < 1.0 - tolerance;
+        amrex::Print() << "  " << r.name << ": " << ratio
+                       << " of the baseline" << (slow ? " (REGRESSION)" : "")
+                       << "\n";
+        if (slow) {
+          status = 1;
+        }
+      }
+    }
+
+    transport_close();
+    EOS::close();
+  }
+  amrex::Finalize();
+  return status;
+}
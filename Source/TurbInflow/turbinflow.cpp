@@ -1,120 +1,403 @@
-
 #include <cstdlib>
 #include <cstring>
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <map>
+#include <set>
+#include <vector>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <deque>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include <AMReX_REAL.H>
 #include <AMReX_Utility.H>
 #include <AMReX_EBFArrayBox.H>
+#include <AMReX_FabConv.H>
 #include <AMReX_ParallelDescriptor.H>
-
-#ifdef _OPENM
-#include <omp.h>
-#endif
+#include <AMReX_ParmParse.H>
+#include <AMReX.H>
 
 using namespace std;
 using namespace amrex;
 
+namespace
+{
+//
+// Read-only stream over a piece of memory, so that a plane can be decoded
+// straight out of the memory-mapped DAT file.
+//
+struct MemBuf
+    : std::streambuf
+{
+    MemBuf (const char* b, size_t n)
+    {
+        char* p = const_cast<char*>(b);
+        setg(p, p, p + n);
+    }
+};
 
-extern "C" void getplane(int* filename, int* len, Real* data, int* plane, int* ncomp, int* isswirltype);
-
+//
+// Read the first component of a FAB written by FArrayBox::writeOn, as
+// FArrayBox::readFrom does but without allocating a fab.
+//
 void
-getplane (int* filename, int* len, Real* data, int* plane, int* ncomp, int* isswirltype)
+read_plane (std::istream& is, std::vector<Real>& out)
 {
-#ifdef _OPENMP
-    int nthreads = omp_get_max_threads();
-    int tid = omp_get_thread_num();
-#else
-    int nthreads = 1;
-    int tid = 0;
-#endif
-
-    static int         kmax;
-    static bool        first = true;
-    static Vector< Vector<long> > offset(nthreads);
-    std::string        flctfile;
+    char f, a, b;
+    is >> f >> a >> b;
+    if (f != 'F' || a != 'A' || b != 'B' || is.peek() == ':')
+        amrex::Abort("getplane(): expected a FAB in the native binary format");
 
-#ifdef _OPENMP
-#pragma omp threadprivate (kmax, first)
-#endif
+    RealDescriptor rd;
+    Box bx;
+    int nvar = 0;
+    is >> rd >> bx >> nvar;
+    is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+    if (is.fail() || nvar < 1)
+        amrex::Abort("getplane(): failed to read the FAB header");
 
+    out.resize(bx.numPts() * nvar);
+    RealDescriptor::convertToNativeFormat(out.data(), out.size(), is, rd);
+    if (is.fail())
+        amrex::Abort("getplane(): failed to read the FAB data");
+    out.resize(bx.numPts());
+}
 
-    for (int i = 0; i < *len; i++)
-    {
-        char c = filename[i];
+//
+// Planes of one turbulent inflow file, shared by all the threads.
+//
+// The HDR offsets are read once and the DAT file is memory-mapped. Decoded
+// planes are kept in a ring buffer, and every request queues the next
+// planes of the same component for a background thread, so that the
+// sliding window of store_planes finds them already decoded. The planes
+// are decoded into plain host buffers, so that the background thread never
+// allocates from the AMReX arenas; they are only copied into the fabs by
+// the calling thread.
+//
+class TurbInflowPlanes
+{
+public:
 
-        flctfile += c;
-    }
+    TurbInflowPlanes (const std::string& flctfile, int isswirltype);
 
-    if (first)
-    {
-        //
-        // Read and save all the seekp() offsets in the inflow header file.
-        //
-        first = false;
+    ~TurbInflowPlanes ();
 
-        std::string hdr = flctfile; hdr += "/HDR";
+    // Copy plane (0-based) of component comp (0-based) into data.
+    void get (Real* data, int plane, int comp);
 
-        std::ifstream ifs;
+private:
 
-        ifs.open(hdr.c_str(), std::ios::in);
+    using Key = std::pair<int,int>;
 
-        if (!ifs.good())
-            amrex::FileOpenFailed(hdr);
+    // Decode a plane without touching the cache.
+    void decode (int plane, int comp, std::vector<Real>& out) const;
+
+    // Store a decoded plane in the ring buffer.  Lock must be held.
+    void insert (const Key& key, std::vector<Real>&& v);
+
+    void prefetch_loop ();
+
+    std::string        m_dat;
+    int                m_kmax = 0;
+    Vector<long>       m_offset;
+
+    const char*        m_map = nullptr;
+    size_t             m_mapsize = 0;
+
+    // Ring buffer of decoded planes
+    int                           m_capacity = 0;
+    int                           m_next = 0;
+    Vector<Key>                   m_slot_key;
+    Vector<std::vector<Real>>     m_slot_data;
+    std::map<Key,int>             m_index;
+
+    // Background decoding of the planes ahead of the requests, each queued
+    // at most once
+    int                           m_depth = 16;
+    std::deque<Key>               m_queue;
+    std::set<Key>                 m_queued;
+    std::thread                   m_thread;
+    bool                          m_stop = false;
+
+    mutable std::mutex            m_mutex;
+    std::condition_variable       m_cv;
+};
+
+TurbInflowPlanes::TurbInflowPlanes (const std::string& flctfile, int isswirltype)
+{
+    //
+    // By default, room for prefetch_planes planes ahead of and behind the
+    // requests of each component.
+    //
+    ParmParse pp("turbinflow");
+    pp.query("prefetch_planes", m_depth);
+    m_depth = std::max(m_depth, 0);
+    m_capacity = 2 * std::max(m_depth, 1) * AMREX_SPACEDIM;
+    pp.query("cache_planes", m_capacity);
+
+    //
+    // Read and save all the seekp() offsets in the inflow header file.
+    //
+    std::string hdr = flctfile; hdr += "/HDR";
 
-        int  idummy;
-        Real rdummy;
+    std::ifstream ifs;
+
+    ifs.open(hdr.c_str(), std::ios::in);
+
+    if (!ifs.good())
+        amrex::FileOpenFailed(hdr);
+
+    int  idummy;
+    Real rdummy;
+    //
+    // Hardwire loop max to 3 regardless of spacedim.
+    //
+    for (int i = 0; i < 3; i++)
+        ifs >> m_kmax;
+
+    ifs >> rdummy >> rdummy >> rdummy;
+    ifs >> idummy >> idummy >> idummy;
+
+    if (isswirltype)
+    {
         //
-        // Hardwire loop max to 3 regardless of spacedim.
+        // Skip over fluct_times array.
         //
-        for (int i = 0; i < 3; i++)
-            ifs >> kmax;
+        for (int i = 0; i < m_kmax; i++)
+            ifs >> rdummy;
+    }
+
+    m_offset.resize(m_kmax*AMREX_SPACEDIM,0);
+
+    for (int i = 0; i < m_offset.size(); i++)
+        ifs >> m_offset[i];
+
+    m_dat = flctfile; m_dat += "/DAT";
+
+    int fd = open(m_dat.c_str(), O_RDONLY);
 
-        ifs >> rdummy >> rdummy >> rdummy;
-        ifs >> idummy >> idummy >> idummy;
+    if (fd < 0)
+        amrex::FileOpenFailed(m_dat);
 
-        if (*isswirltype)
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        void* p = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (p != MAP_FAILED)
         {
-            //
-            // Skip over fluct_times array.
-            //
-            for (int i = 0; i < kmax; i++)
-                ifs >> rdummy;
+            m_map = static_cast<const char*>(p);
+            m_mapsize = st.st_size;
         }
-
-        offset[tid].resize(kmax*AMREX_SPACEDIM,0);
-           
-        for (int i = 0; i < offset[tid].size(); i++)
-            ifs >> offset[tid][i];
     }
+    close(fd);
 
-    std::string dat = flctfile; dat += "/DAT";
+    //
+    // Prefetched planes must not evict each other before being requested.
+    //
+    m_capacity = std::max(m_capacity, 1);
+    m_depth = std::min(m_depth, m_capacity - 1);
+    m_slot_key.resize(m_capacity, Key(-1,-1));
+    m_slot_data.resize(m_capacity);
 
-    std::ifstream ifs;
+    if (m_depth > 0)
+        m_thread = std::thread(&TurbInflowPlanes::prefetch_loop, this);
+}
 
-    ifs.open(dat.c_str(), std::ios::in);
+TurbInflowPlanes::~TurbInflowPlanes ()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
 
-    if (!ifs.good())
-        amrex::FileOpenFailed(dat);
+    if (m_thread.joinable())
+        m_thread.join();
+
+    if (m_map != nullptr)
+        munmap(const_cast<char*>(m_map), m_mapsize);
+}
+
+void
+TurbInflowPlanes::decode (int plane, int comp, std::vector<Real>& out) const
+{
     //
     // There are BL_SPACEDIM * kmax planes of FABs.
     // The first component are in the first kmax planes,
     // the second component in the next kmax planes, ....
-    // Note also that both (*plane) and (*ncomp) start from
-    // 1 not 0 since they're passed from Fortran.
     //
-    const long start = offset[tid][((*plane) - 1) + (((*ncomp) - 1) * kmax)] ;
+    const long start = m_offset[plane + comp * m_kmax];
 
-    ifs.seekg(start, std::ios::beg);
+    if (m_map != nullptr)
+    {
+        if (start < 0 || static_cast<size_t>(start) >= m_mapsize)
+            amrex::Abort("getplane(): offset beyond the end of " + m_dat);
 
-    if (!ifs.good())
-        amrex::Abort("getplane(): seekg() failed");
+        MemBuf buf(m_map + start, m_mapsize - start);
+        std::istream is(&buf);
+        read_plane(is, out);
+    }
+    else
+    {
+        std::ifstream ifs;
+
+        ifs.open(m_dat.c_str(), std::ios::in);
+
+        if (!ifs.good())
+            amrex::FileOpenFailed(m_dat);
+
+        ifs.seekg(start, std::ios::beg);
+
+        if (!ifs.good())
+            amrex::Abort("getplane(): seekg() failed");
+
+        read_plane(ifs, out);
+    }
+}
+
+void
+TurbInflowPlanes::insert (const Key& key, std::vector<Real>&& v)
+{
+    if (m_index.count(key) > 0)
+        return;
+
+    const int slot = m_next;
+    m_next = (m_next + 1) % m_capacity;
+
+    m_index.erase(m_slot_key[slot]);
+    m_slot_key[slot] = key;
+    m_slot_data[slot] = std::move(v);
+    m_index[key] = slot;
+}
+
+void
+TurbInflowPlanes::get (Real* data, int plane, int comp)
+{
+    const Key key(plane, comp);
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        //
+        // Queue the planes that follow for the background thread.
+        //
+        if (m_depth > 0)
+        {
+            for (int d = 1; d <= std::min(m_depth, m_kmax - 1); d++)
+            {
+                const Key ahead((plane + d) % m_kmax, comp);
+                if (m_index.count(ahead) == 0 &&
+                    m_queued.count(ahead) == 0 &&
+                    m_queue.size() < static_cast<size_t>(m_capacity))
+                {
+                    m_queue.push_back(ahead);
+                    m_queued.insert(ahead);
+                }
+            }
+            m_cv.notify_one();
+        }
+
+        auto it = m_index.find(key);
+        if (it != m_index.end())
+        {
+            const std::vector<Real>& v = m_slot_data[it->second];
+            memcpy(data, v.data(), v.size()*sizeof(Real));
+            return;
+        }
+    }
+
+    std::vector<Real> v;
+    decode(plane, comp, v);
+    memcpy(data, v.data(), v.size()*sizeof(Real));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    insert(key, std::move(v));
+}
+
+void
+TurbInflowPlanes::prefetch_loop ()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while (true)
+    {
+        m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+
+        if (m_stop)
+            return;
+
+        //
+        // The plane stays in m_queued while it is decoded, so that it is
+        // not queued again meanwhile.
+        //
+        const Key key = m_queue.front();
+        m_queue.pop_front();
 
-    FArrayBox fab;
+        if (m_index.count(key) == 0)
+        {
+            lock.unlock();
+            std::vector<Real> v;
+            decode(key.first, key.second, v);
+            lock.lock();
 
-    fab.readFrom(ifs);
+            insert(key, std::move(v));
+        }
+        m_queued.erase(key);
+    }
+}
 
-    memcpy(data, fab.dataPtr(), fab.box().numPts()*sizeof(Real));
+std::mutex turbinflow_mutex;
+std::map<std::string, std::unique_ptr<TurbInflowPlanes>> turbinflow_files;
+}
+
+extern "C" void getplane(int* filename, int* len, Real* data, int* plane, int* ncomp, int* isswirltype);
+
+void
+getplane (int* filename, int* len, Real* data, int* plane, int* ncomp, int* isswirltype)
+{
+    std::string        flctfile;
+
+    for (int i = 0; i < *len; i++)
+    {
+        char c = filename[i];
+
+        flctfile += c;
+    }
+
+    TurbInflowPlanes* planes = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(turbinflow_mutex);
+
+        if (turbinflow_files.empty())
+        {
+            //
+            // Stop the prefetch threads while AMReX is still around.
+            //
+            amrex::ExecOnFinalize([] () {
+                std::lock_guard<std::mutex> flock(turbinflow_mutex);
+                turbinflow_files.clear();
+            });
+        }
+
+        auto& p = turbinflow_files[flctfile];
+        if (!p)
+            p.reset(new TurbInflowPlanes(flctfile, *isswirltype));
+
+        planes = p.get();
+    }
+    //
+    // Note that both (*plane) and (*ncomp) start from
+    // 1 not 0 since they're passed from Fortran.
+    //
+    planes->get(data, (*plane) - 1, (*ncomp) - 1);
 }
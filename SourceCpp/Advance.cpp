@@ -5,6 +5,109 @@
 #include "PeleC.H"
 #include "IndexDefines.H"
 
+namespace {
+// Explicit Runge-Kutta schemes for the MOL advance. Each stage s does
+//   dU <- A_s dU + dt L(U)
+//   U  <- alpha_s U^n + (1 - alpha_s) (U + B_s dU)
+// which covers the 2N-storage schemes of Williamson (alpha_s = 0) and the
+// SSP schemes in Shu-Osher form (A_s = 0, B_s = 1). Only U^n, U, L(U) and,
+// for 2N schemes, dU are held in memory.
+struct MOLRKScheme
+{
+  static constexpr int max_stages = 5;
+  int nstages = 0;
+  amrex::Real A[max_stages] = {0.0};
+  amrex::Real B[max_stages] = {0.0};
+  amrex::Real alpha[max_stages] = {0.0};
+  amrex::Real c[max_stages] = {0.0};
+  // weight of each stage's L(U) in the final update, used for refluxing
+  amrex::Real w[max_stages] = {0.0};
+
+  bool needs_du() const
+  {
+    for (int s = 0; s < nstages; ++s) {
+      if (A[s] != 0.0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void compute_weights()
+  {
+    amrex::Real wdu[max_stages][max_stages] = {{0.0}};
+    amrex::Real wu[max_stages] = {0.0};
+    for (int s = 0; s < nstages; ++s) {
+      for (int j = 0; j < nstages; ++j) {
+        const amrex::Real dprev = (s > 0) ? wdu[s - 1][j] : 0.0;
+        wdu[s][j] = A[s] * dprev + ((j == s) ? 1.0 : 0.0);
+        wu[j] = (1.0 - alpha[s]) * (wu[j] + B[s] * wdu[s][j]);
+      }
+    }
+    for (int j = 0; j < nstages; ++j) {
+      w[j] = wu[j];
+    }
+  }
+};
+
+MOLRKScheme
+get_mol_rk_scheme(const int scheme)
+{
+  MOLRKScheme rk;
+  if (scheme == 3) {
+    // SSP-RK3 (Shu & Osher 1988)
+    rk.nstages = 3;
+    const amrex::Real alpha[3] = {0.0, 0.75, 1.0 / 3.0};
+    const amrex::Real c[3] = {0.0, 1.0, 0.5};
+    for (int s = 0; s < rk.nstages; ++s) {
+      rk.B[s] = 1.0;
+      rk.alpha[s] = alpha[s];
+      rk.c[s] = c[s];
+    }
+  } else if (scheme == 4) {
+    // 2N-storage RK4(5) (Carpenter & Kennedy 1994, solution 3)
+    rk.nstages = 5;
+    const amrex::Real A[5] = {
+      0.0, -567301805773.0 / 1357537059087.0,
+      -2404267990393.0 / 2016746695238.0, -3550918686646.0 / 2091501179385.0,
+      -1275806237668.0 / 842570457699.0};
+    const amrex::Real B[5] = {
+      1432997174477.0 / 9575080441755.0, 5161836677717.0 / 13612068292357.0,
+      1720146321549.0 / 2090206949498.0, 3134564353537.0 / 4481467310338.0,
+      2277821191437.0 / 14882151754819.0};
+    const amrex::Real c[5] = {
+      0.0, 1432997174477.0 / 9575080441755.0,
+      2526269341429.0 / 6820363962896.0, 2006345519317.0 / 3224310063776.0,
+      2802321613138.0 / 2924317926251.0};
+    for (int s = 0; s < rk.nstages; ++s) {
+      rk.A[s] = A[s];
+      rk.B[s] = B[s];
+      rk.c[s] = c[s];
+    }
+  } else {
+    amrex::Abort("get_mol_rk_scheme: unknown mol_rk_scheme");
+  }
+  rk.compute_weights();
+  return rk;
+}
+
+// (Re)define a persistent register if the level layout changed
+void
+define_mol_register(
+  amrex::MultiFab& mf,
+  const amrex::BoxArray& ba,
+  const amrex::DistributionMapping& dm,
+  const int ncomp,
+  const amrex::FabFactory<amrex::FArrayBox>& factory)
+{
+  if (
+    !mf.ok() || mf.boxArray() != ba || mf.DistributionMap() != dm ||
+    mf.nComp() != ncomp) {
+    mf.define(ba, dm, ncomp, 0, amrex::MFInfo(), factory);
+  }
+}
+} // namespace
+
 amrex::Real
 PeleC::advance(
   amrex::Real time, amrex::Real dt, int amr_iteration, int amr_ncycle)
@@ -49,6 +152,10 @@ PeleC::do_mol_advance(
 {
   BL_PROFILE("PeleC::do_mol_advance()");
 
+  if (mol_rk_scheme != 2) {
+    return do_mol_rk_advance(time, dt, amr_iteration, amr_ncycle);
+  }
+
   // Check that we are not asking to advance stuff we don't know to
   // if (src_list.size() > 0) amrex::Abort("Have not integrated other sources
   // into MOL advance yet");
@@ -73,12 +180,14 @@ PeleC::do_mol_advance(
   amrex::MultiFab& S_new = get_new_data(State_Type);
 
   // define sourceterm
-  amrex::MultiFab molSrc(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+  define_mol_register(mol_src, grids, dmap, NVAR, Factory());
+  amrex::MultiFab& molSrc = mol_src;
 
-  amrex::MultiFab molSrc_old, molSrc_new;
+  amrex::MultiFab& molSrc_old = mol_src_old;
+  amrex::MultiFab& molSrc_new = mol_src_new;
   if (mol_iters > 1) {
-    molSrc_old.define(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
-    molSrc_new.define(grids, dmap, NVAR, 0, amrex::MFInfo(), Factory());
+    define_mol_register(molSrc_old, grids, dmap, NVAR, Factory());
+    define_mol_register(molSrc_new, grids, dmap, NVAR, Factory());
   }
 
 #ifdef PELEC_USE_REACTIONS
@@ -94,7 +203,8 @@ PeleC::do_mol_advance(
   if (verbose) {
     amrex::Print() << "... Computing MOL source term at t^{n} " << std::endl;
   }
-  FillPatch(*this, Sborder, nGrowTr, time, State_Type, 0, NVAR);
+  transport_cache_refresh = true;
+  fill_mol_sborder(Sborder, time);
   amrex::Real flux_factor = 0;
   getMOLSrcTerm(Sborder, molSrc, time, dt, flux_factor);
 
@@ -135,7 +245,7 @@ PeleC::do_mol_advance(
   if (verbose) {
     amrex::Print() << "... Computing MOL source term at t^{n+1} " << std::endl;
   }
-  FillPatch(*this, Sborder, nGrowTr, time + dt, State_Type, 0, NVAR);
+  fill_mol_sborder(Sborder, time + dt);
   flux_factor = mol_iters > 1 ? 0 : 1;
   getMOLSrcTerm(Sborder, molSrc, time, dt, flux_factor);
 
@@ -189,7 +299,7 @@ PeleC::do_mol_advance(
         amrex::Print() << "... Re-computing MOL source term at t^{n+1} (iter = "
                        << mol_iter << " of " << mol_iters << ")" << std::endl;
       }
-      FillPatch(*this, Sborder, nGrowTr, time + dt, State_Type, 0, NVAR);
+      fill_mol_sborder(Sborder, time + dt);
       flux_factor = mol_iter == mol_iters ? 1 : 0;
       getMOLSrcTerm(Sborder, molSrc_new, time, dt, flux_factor);
 
@@ -212,6 +322,181 @@ PeleC::do_mol_advance(
   return dt;
 }
 
+amrex::Real
+PeleC::do_mol_rk_advance(
+  amrex::Real time, amrex::Real dt, int amr_iteration, int amr_ncycle)
+{
+  BL_PROFILE("PeleC::do_mol_rk_advance()");
+
+  const MOLRKScheme rk = get_mol_rk_scheme(mol_rk_scheme);
+
+  for (int i = 0; i < num_state_type; ++i) {
+    bool skip = false;
+#ifdef PELEC_USE_REACTIONS
+    skip = i == Reactions_Type && do_react;
+#endif
+    if (!skip) {
+      state[i].allocOldData();
+      state[i].swapTimeLevels(dt);
+    }
+  }
+
+  if (do_mol_load_balance || do_react_load_balance) {
+    get_new_data(Work_Estimate_Type).setVal(0.0);
+  }
+
+  amrex::MultiFab& S_old = get_old_data(State_Type);
+  amrex::MultiFab& S_new = get_new_data(State_Type);
+
+  define_mol_register(mol_src, grids, dmap, NVAR, Factory());
+  if (rk.needs_du()) {
+    define_mol_register(mol_rk_du, grids, dmap, NVAR, Factory());
+  }
+
+#ifdef PELEC_USE_REACTIONS
+  amrex::MultiFab& I_R = get_new_data(Reactions_Type);
+#endif
+
+#ifdef PELEC_USE_EB
+  set_body_state(S_old);
+  set_body_state(S_new);
+#endif
+
+  for (int s = 0; s < rk.nstages; ++s) {
+    const amrex::Real stage_time = time + rk.c[s] * dt;
+    if (verbose) {
+      amrex::Print() << "... Computing MOL source term for RK stage " << s + 1
+                     << " of " << rk.nstages << std::endl;
+    }
+
+    // The stage state lives in the new-time data, so fill from there
+    // after the first stage
+    if (s == 0) {
+      transport_cache_refresh = true;
+    }
+    fill_mol_sborder(Sborder, (s == 0) ? time : time + dt);
+    getMOLSrcTerm(Sborder, mol_src, stage_time, dt, rk.w[s]);
+
+    // Build other (neither spray nor diffusion) sources at the stage
+    for (int n = 0; n < src_list.size(); ++n) {
+      if (
+        src_list[n] != diff_src
+#ifdef AMREX_PARTICLES
+        && src_list[n] != spray_src
+#endif
+      ) {
+        if (s == 0) {
+          construct_old_source(
+            src_list[n], time, dt, amr_iteration, amr_ncycle, 0, 0);
+          amrex::MultiFab::Saxpy(
+            mol_src, 1.0, *old_sources[src_list[n]], 0, 0, NVAR, 0);
+        } else {
+          construct_new_source(
+            src_list[n], stage_time, dt, amr_iteration, amr_ncycle, 0, 0);
+          amrex::MultiFab::Saxpy(
+            mol_src, 1.0, *new_sources[src_list[n]], 0, 0, NVAR, 0);
+        }
+      }
+    }
+
+#ifdef PELEC_USE_REACTIONS
+    // Lagged reaction source from the previous step
+    if (do_react == 1) {
+      amrex::MultiFab::Add(mol_src, I_R, 0, FirstSpec, NUM_SPECIES, 0);
+      amrex::MultiFab::Add(mol_src, I_R, NUM_SPECIES, Eden, 1, 0);
+    }
+#endif
+
+    if (rk.needs_du()) {
+      // dU = A_s dU + dt L(U), U = U + B_s dU
+      if (s == 0) {
+        amrex::MultiFab::Copy(mol_rk_du, mol_src, 0, 0, NVAR, 0);
+        mol_rk_du.mult(dt);
+      } else {
+        amrex::MultiFab::LinComb(
+          mol_rk_du, rk.A[s], mol_rk_du, 0, dt, mol_src, 0, 0, NVAR, 0);
+      }
+      amrex::MultiFab::LinComb(
+        S_new, 1.0, Sborder, 0, rk.B[s], mol_rk_du, 0, 0, NVAR, 0);
+    } else {
+      amrex::MultiFab::LinComb(
+        S_new, 1.0, Sborder, 0, rk.B[s] * dt, mol_src, 0, 0, NVAR, 0);
+    }
+    if (rk.alpha[s] != 0.0) {
+      amrex::MultiFab::LinComb(
+        S_new, rk.alpha[s], S_old, 0, 1.0 - rk.alpha[s], S_new, 0, 0, NVAR, 0);
+    }
+
+    computeTemp(S_new, 0);
+  }
+
+#ifdef PELEC_USE_REACTIONS
+  if (do_react == 1) {
+    // F_{AD} = (1/dt)(U^{n+1,*} - U^n) - I_R
+    amrex::MultiFab::LinComb(
+      mol_src, 1.0 / dt, S_new, 0, -1.0 / dt, S_old, 0, 0, NVAR, 0);
+    amrex::MultiFab::Subtract(mol_src, I_R, 0, FirstSpec, NUM_SPECIES, 0);
+    amrex::MultiFab::Subtract(mol_src, I_R, NUM_SPECIES, Eden, 1, 0);
+
+    // Compute I_R and U^{n+1} = U^n + dt*(F_{AD} + I_R)
+    react_state(time, dt, false, &mol_src);
+
+    computeTemp(S_new, 0);
+  }
+#endif
+
+#ifdef PELEC_USE_EB
+  set_body_state(S_new);
+#endif
+
+  return dt;
+}
+
+void
+PeleC::fill_mol_sborder(amrex::MultiFab& S_border, amrex::Real time)
+{
+  BL_PROFILE("PeleC::fill_mol_sborder()");
+
+  // Fine levels also need coarse data in their ghost cells
+  if (!mol_overlap_comm || level > 0) {
+    FillPatch(*this, S_border, nGrowTr, time, State_Type, 0, NVAR);
+    return;
+  }
+
+  // Same as FillPatch on the coarsest level, with the exchange between grids
+  // left in flight while the transport coefficients of the valid cells are
+  // evaluated
+  const amrex::Real strt = amrex::ParallelDescriptor::second();
+  amrex::MultiFab::Copy(S_border, get_data(State_Type, time), 0, 0, NVAR, 0);
+  S_border.FillBoundary_nowait(geom.periodicity());
+  fill_transport_cache(S_border, true);
+  amrex::Gpu::streamSynchronize();
+  const amrex::Real wait = amrex::ParallelDescriptor::second();
+  S_border.FillBoundary_finish();
+  const amrex::Real end = amrex::ParallelDescriptor::second();
+
+  amrex::StateDataPhysBCFunct physbcf(state[State_Type], 0, geom);
+  physbcf(S_border, 0, NVAR, S_border.nGrowVect(), time, 0);
+
+  overlap_transport_time += wait - strt;
+  overlap_wait_time += end - wait;
+}
+
+void
+PeleC::print_overlap_stats()
+{
+  amrex::Real times[2] = {overlap_transport_time, overlap_wait_time};
+  amrex::ParallelDescriptor::ReduceRealMax(times, 2);
+  amrex::Print() << "Ghost cell exchange: " << times[0]
+                 << " s of valid cell transport coefficient evaluation "
+                 << "overlapped with it";
+  if (mol_transport_cache != 0) {
+    amrex::Print() << " (mostly cache checks)";
+  }
+  amrex::Print() << ", " << times[1] << " s waiting for it to complete"
+                 << std::endl;
+}
+
 #ifdef AMREX_PARTICLES
 void
 PeleC::setSprayGridInfo(
@@ -1,4 +1,5 @@
 #include "Diffusion.H"
+#include "ScratchArena.H"
 
 void
 PeleC::getMOLSrcTerm(
@@ -75,6 +76,28 @@ PeleC::getMOLSrcTerm(
   prefetchToDevice(S);
   prefetchToDevice(MOLSrcTerm);
 
+  const bool use_transport_cache =
+    mol_transport_cache != 0 || mol_overlap_comm != 0;
+  if (use_transport_cache) {
+    fill_transport_cache(S);
+  }
+
+  // Tile (pencil) size of the source term evaluation. All the temporaries of
+  // a tile are drawn from the scratch arena, so small tiles keep the whole
+  // chain of kernels in cache.
+  const bool tune_tiles = mol_tile_autotune != 0 && amrex::TilingIfNotGPU();
+  amrex::IntVect tile_size = amrex::FabArrayBase::mfiter_tile_size;
+  if (tune_tiles) {
+    tile_size = mol_tile_tuner.next();
+  } else if (mol_tile_size.allGT(0)) {
+    tile_size = mol_tile_size;
+  }
+  amrex::MFItInfo mfi_info;
+  if (amrex::TilingIfNotGPU()) {
+    mfi_info.EnableTiling(tile_size);
+  }
+  const amrex::Real tile_timer = amrex::ParallelDescriptor::second();
+
 #ifdef PELEC_USE_EB
   auto const& fact =
     dynamic_cast<amrex::EBFArrayBoxFactory const&>(S.Factory());
@@ -115,8 +138,10 @@ PeleC::getMOLSrcTerm(
     const int* domain_lo = geom.Domain().loVect();
     const int* domain_hi = geom.Domain().hiVect();
 
-    for (amrex::MFIter mfi(MOLSrcTerm, amrex::TilingIfNotGPU()); mfi.isValid();
-         ++mfi) {
+    ScratchArena& scratch = ScratchArena::get();
+
+    for (amrex::MFIter mfi(MOLSrcTerm, mfi_info); mfi.isValid(); ++mfi) {
+      scratch.reset();
       const amrex::Box vbox = mfi.tilebox();
       int ng = S.nGrow();
       const amrex::Box gbox = amrex::grow(vbox, ng);
@@ -152,6 +177,15 @@ PeleC::getMOLSrcTerm(
       eb_flux_thdlocal.define(sv_eb_bndry_grad_stencil[local_i], NVAR);
       auto* d_sv_eb_bndry_geom =
         (Ncut > 0 ? sv_eb_bndry_geom[local_i].data() : 0);
+
+      // Cut cells of the fab touched by this tile's EB flux and
+      // redistribution, so that those passes do not scale with the fab
+      amrex::Gpu::DeviceVector<int> v_eb_tile_cut;
+      const int Ntile = pc_compact_index(
+        Ncut, v_eb_tile_cut, [=] AMREX_GPU_DEVICE(int icut) noexcept {
+          return ebfluxbox.contains(d_sv_eb_bndry_geom[icut].iv);
+        });
+      const int* eb_tile_cut = v_eb_tile_cut.data();
 #endif
 
       const int* lo = vbox.loVect();
@@ -159,10 +193,15 @@ PeleC::getMOLSrcTerm(
 
       BL_PROFILE_VAR_START(diff);
       int nqaux = NQAUX > 0 ? NQAUX : 1;
-      amrex::FArrayBox q(gbox, QVAR), qaux(gbox, nqaux),
-        coeff_cc(gbox, nCompTr);
+      amrex::FArrayBox q = scratch.fab(gbox, QVAR);
+      amrex::FArrayBox qaux = scratch.fab(gbox, nqaux);
       amrex::Elixir qeli = q.elixir();
       amrex::Elixir qauxeli = qaux.elixir();
+      amrex::FArrayBox coeff_cc =
+        use_transport_cache
+          ? amrex::FArrayBox(
+              transport_cache[mfi], amrex::make_alias, 0, nCompTr)
+          : scratch.fab(gbox, nCompTr);
       amrex::Elixir coefeli = coeff_cc.elixir();
       auto const& s = S.array(mfi);
       auto const& qar = q.array();
@@ -213,7 +252,7 @@ PeleC::getMOLSrcTerm(
 
       // Compute transport coefficients, coincident with Q
       auto const& coe_cc = coeff_cc.array();
-      {
+      if (!use_transport_cache) {
         auto const& qar_yin = q.array(QFS);
         auto const& qar_Tin = q.array(QTEMP);
         auto const& qar_rhoin = q.array(QRHO);
@@ -241,13 +280,13 @@ PeleC::getMOLSrcTerm(
         a{AMREX_D_DECL(
           area[0].array(mfi), area[1].array(mfi), area[2].array(mfi))};
       for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
-        flux_ec[dir].resize(eboxes[dir], NVAR);
+        flux_ec[dir] = scratch.fab(eboxes[dir], NVAR);
         flux_eli[dir] = flux_ec[dir].elixir();
         flx[dir] = flux_ec[dir].array();
         setV(eboxes[dir], NVAR, flx[dir], 0);
       }
 
-      amrex::FArrayBox Dfab(cbox, NVAR);
+      amrex::FArrayBox Dfab = scratch.fab(cbox, NVAR);
       amrex::Elixir Dfab_eli = Dfab.elixir();
       auto const& Dterm = Dfab.array();
       setV(cbox, NVAR, Dterm, 0.0);
@@ -360,7 +399,7 @@ PeleC::getMOLSrcTerm(
           diffusion_flux_arr;
         if (use_explicit_filter) {
           for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
-            diffusion_flux[dir].resize(flux_ec[dir].box(), NVAR);
+            diffusion_flux[dir] = scratch.fab(flux_ec[dir].box(), NVAR);
             diffusion_flux_eli[dir] = diffusion_flux[dir].elixir();
             diffusion_flux_arr[dir] = diffusion_flux[dir].array();
             copy_array4(
@@ -378,7 +417,7 @@ PeleC::getMOLSrcTerm(
 #endif
           auto const& vol = volume.array(mfi);
           pc_compute_hyp_mol_flux(
-            cbox, qar, qauxar, flx, a, dx, plm_iorder
+            cbox, qar, qauxar, flx, a, dx, plm_iorder, riemann_solver
 #ifdef PELEC_USE_EB
             ,
             eb_small_vfrac, vfrac.array(mfi), flags.array(mfi),
@@ -395,7 +434,7 @@ PeleC::getMOLSrcTerm(
           amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM>
             hydro_flux_arr;
           for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
-            hydro_flux[dir].resize(flux_ec[dir].box(), NVAR);
+            hydro_flux[dir] = scratch.fab(flux_ec[dir].box(), NVAR);
             hydro_flux_eli[dir] = hydro_flux[dir].elixir();
             hydro_flux_arr[dir] = hydro_flux[dir].array();
             lincomb_array4(
@@ -407,8 +446,7 @@ PeleC::getMOLSrcTerm(
           const amrex::Box fbox = amrex::grow(cbox, -nGrowF);
           for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
             const amrex::Box& bxtmp = amrex::surroundingNodes(fbox, dir);
-            amrex::FArrayBox filtered_hydro_flux;
-            filtered_hydro_flux.resize(bxtmp, NVAR);
+            amrex::FArrayBox filtered_hydro_flux = scratch.fab(bxtmp, NVAR);
             amrex::Elixir filtered_hydro_flux_eli =
               filtered_hydro_flux.elixir();
             les_filter.apply_filter(
@@ -448,15 +486,9 @@ PeleC::getMOLSrcTerm(
 #endif
 
 #ifdef PELEC_USE_EB
-      amrex::Gpu::DeviceVector<int> v_eb_tile_mask(Ncut, 0);
-      int* eb_tile_mask = v_eb_tile_mask.dataPtr();
-      amrex::ParallelFor(Ncut, [=] AMREX_GPU_DEVICE(int icut) {
-        if (ebfluxbox.contains(d_sv_eb_bndry_geom[icut].iv)) {
-          eb_tile_mask[icut] = 1;
-        }
-      });
       if (typ == amrex::FabType::singlevalued) {
-        sv_eb_flux[local_i].merge(eb_flux_thdlocal, 0, NVAR, v_eb_tile_mask);
+        sv_eb_flux[local_i].merge(
+          eb_flux_thdlocal, 0, NVAR, eb_tile_cut, Ntile);
       }
 
       amrex::FArrayBox dm_as_fine, fab_drho_as_crse;
@@ -503,10 +535,6 @@ PeleC::getMOLSrcTerm(
         for (int dir = 0; dir < AMREX_SPACEDIM; ++dir)
           vol *= geom.CellSize()[dir];
 
-        // Set weighting for redistribution
-        auto const& W = vfrac.array(mfi);
-        int wComp = 0;
-
         dm_as_fine.resize(amrex::Box::TheUnitBox(), NVAR);
         dm_as_fine_eli = dm_as_fine.elixir();
         fab_drho_as_crse.resize(amrex::Box::TheUnitBox(), NVAR);
@@ -527,11 +555,12 @@ PeleC::getMOLSrcTerm(
           BL_PROFILE("PeleC::pc_fix_div_and_redistribute()");
           pc_fix_div_and_redistribute(
             vbox, vol, dt, NVAR, eb_small_vfrac, levmsk_notcovered,
-            d_sv_eb_bndry_geom, Ncut, flags.array(mfi),
-            AMREX_D_DECL(flx[0], flx[1], flx[2]), sv_eb_flux[local_i].dataPtr(),
-            nFlux, vfrac.array(mfi), W, as_crse, as_fine, level_mask.array(mfi),
-            (*p_rrflag_as_crse).array(), Dterm, (*p_drho_as_crse).array(),
-            dm_as_fine.array());
+            d_sv_eb_bndry_geom, sv_eb_redist_stencil[local_i].data(), Ncut,
+            eb_tile_cut, Ntile, flags.array(mfi),
+            AMREX_D_DECL(flx[0], flx[1], flx[2]),
+            sv_eb_flux[local_i].dataPtr(), nFlux, vfrac.array(mfi), as_crse,
+            as_fine, level_mask.array(mfi), (*p_rrflag_as_crse).array(), Dterm,
+            (*p_drho_as_crse).array(), dm_as_fine.array());
         }
 
         if (do_reflux && flux_factor != 0) {
@@ -638,5 +667,141 @@ PeleC::getMOLSrcTerm(
       }
 #endif
     } // End of MFIter scope
-  }   // End of OMP scope
+    scratch.reset();
+  } // End of OMP scope
+
+  if (tune_tiles) {
+    amrex::Gpu::streamSynchronize();
+    mol_tile_tuner.record(
+      (amrex::ParallelDescriptor::second() - tile_timer) /
+        MOLSrcTerm.boxArray().d_numPts(),
+      level, verbose);
+  }
 } // End of Function
+
+void
+PeleC::fill_transport_cache(const amrex::MultiFab& S, const bool valid_only)
+{
+  BL_PROFILE("PeleC::fill_transport_cache()");
+
+  const int nCompTr = dComp_lambda + 1;
+  const int ng = S.nGrow();
+  if (
+    transport_cache.nGrow() != ng ||
+    transport_cache.boxArray() != S.boxArray() ||
+    transport_cache.DistributionMap() != S.DistributionMap()) {
+    transport_cache.define(
+      S.boxArray(), S.DistributionMap(), nCompTr, ng, amrex::MFInfo(),
+      S.Factory());
+    transport_cache_ref.define(
+      S.boxArray(), S.DistributionMap(), NUM_SPECIES + 1, ng, amrex::MFInfo(),
+      S.Factory());
+    transport_cache_refresh = true;
+  }
+
+  // Everything is recomputed at the first stage of a step, and always when
+  // the storage is only used to overlap the ghost cell exchange. The valid
+  // cells may have been done already while the ghost cells were exchanged.
+  const bool refresh = transport_cache_refresh || mol_transport_cache == 0;
+  const bool skip_valid = !valid_only && transport_cache_valid_filled;
+  if (valid_only) {
+    transport_cache_valid_filled = true;
+  } else {
+    transport_cache_refresh = false;
+    transport_cache_valid_filled = false;
+  }
+  const amrex::Real tol = mol_transport_cache_tol;
+  const bool check = mol_transport_cache_check != 0;
+
+  amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum, amrex::ReduceOpMax>
+    reduce_op;
+  amrex::ReduceData<long long, long long, amrex::Real> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(transport_cache, amrex::TilingIfNotGPU());
+       mfi.isValid(); ++mfi) {
+    const amrex::Box gbx = valid_only ? mfi.tilebox() : mfi.growntilebox();
+    const amrex::Box vbx = mfi.validbox();
+    auto const& s = S.const_array(mfi);
+    auto const& coe = transport_cache.array(mfi);
+    auto const& ref = transport_cache_ref.array(mfi);
+    reduce_op.eval(
+      gbx, reduce_data,
+      [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept -> ReduceTuple {
+        if (skip_valid && vbx.contains(amrex::IntVect(AMREX_D_DECL(i, j, k)))) {
+          return {0, 0, 0.0};
+        }
+
+        amrex::Real rho, T, massfrac[NUM_SPECIES];
+        pc_transport_state(i, j, k, s, rho, T, massfrac);
+
+        bool stale = refresh;
+        if (!stale) {
+          amrex::Real drift =
+            amrex::Math::abs(T - ref(i, j, k, 0)) / ref(i, j, k, 0);
+          for (int n = 0; n < NUM_SPECIES; ++n) {
+            drift = amrex::max(
+              drift, amrex::Math::abs(massfrac[n] - ref(i, j, k, n + 1)));
+          }
+          stale = !(drift <= tol);
+        }
+
+        amrex::Real c[dComp_lambda + 1];
+        if (stale) {
+          pc_transport_coeffs(rho, T, massfrac, c);
+          for (int n = 0; n < dComp_lambda + 1; ++n) {
+            coe(i, j, k, n) = c[n];
+          }
+          ref(i, j, k, 0) = T;
+          for (int n = 0; n < NUM_SPECIES; ++n) {
+            ref(i, j, k, n + 1) = massfrac[n];
+          }
+          return {0, 1, 0.0};
+        }
+
+        // Deviation of the reused values from freshly computed ones
+        amrex::Real err = 0.0;
+        if (check) {
+          pc_transport_coeffs(rho, T, massfrac, c);
+          for (int n = 0; n < dComp_lambda + 1; ++n) {
+            err = amrex::max(
+              err, amrex::Math::abs(coe(i, j, k, n) - c[n]) /
+                     amrex::max(
+                       amrex::Math::abs(c[n]),
+                       std::numeric_limits<amrex::Real>::min()));
+          }
+        }
+        return {1, 0, err};
+      });
+  }
+
+  ReduceTuple hv = reduce_data.value();
+  transport_cache_hits += amrex::get<0>(hv);
+  transport_cache_misses += amrex::get<1>(hv);
+  transport_cache_max_err =
+    amrex::max(transport_cache_max_err, amrex::get<2>(hv));
+}
+
+void
+PeleC::print_transport_cache_stats()
+{
+  long long counts[2] = {transport_cache_hits, transport_cache_misses};
+  amrex::ParallelDescriptor::ReduceLongSum(counts, 2);
+  amrex::Real max_err = transport_cache_max_err;
+  amrex::ParallelDescriptor::ReduceRealMax(max_err);
+
+  const double total = static_cast<double>(counts[0] + counts[1]);
+  amrex::Print() << "Transport cache: " << counts[0] << " cells reused, "
+                 << counts[1] << " recomputed";
+  if (total > 0.0) {
+    amrex::Print() << " (" << 100.0 * counts[0] / total << "% hit rate)";
+  }
+  amrex::Print() << std::endl;
+  if (mol_transport_cache_check) {
+    amrex::Print() << "Transport cache: max relative error of reused "
+                   << "coefficients = " << max_err << std::endl;
+  }
+}
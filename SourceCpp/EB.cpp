@@ -269,6 +269,78 @@ pc_apply_face_stencil(
   }
 }
 
+// Precompute the geometry-only weights used by pc_fix_div_and_redistribute
+// for each cut cell. The redistribution weights are the volume fractions.
+void
+pc_fill_redist_stencil(
+  const amrex::Box bx,
+  const int Ncut,
+  const EBBndryGeom* sv_ebg,
+  const amrex::Array4<amrex::EBCellFlag const>& flags,
+  const amrex::Array4<const amrex::Real>& vf,
+  const amrex::Real eb_small_vfrac,
+  EBRedistSten* sten)
+{
+  const auto lo = amrex::lbound(bx);
+  const auto hi = amrex::ubound(bx);
+  amrex::ParallelFor(Ncut, [=] AMREX_GPU_DEVICE(int L) {
+    const int i = sv_ebg[L].iv[0];
+    const int j = sv_ebg[L].iv[1];
+    const int k = sv_ebg[L].iv[2];
+    for (int ii = -1; ii <= 1; ii++) {
+      for (int jj = -1; jj <= 1; jj++) {
+        for (int kk = -1; kk <= 1; kk++) {
+          sten[L].dnc[ii + 1][jj + 1][kk + 1] = 0.0;
+          sten[L].rd[ii + 1][jj + 1][kk + 1] = 0.0;
+          sten[L].rr[ii + 1][jj + 1][kk + 1] = 0.0;
+        }
+      }
+    }
+
+    // The stencil needs all the neighbors
+    if (!is_inside(i, j, k, lo, hi, -1)) {
+      return;
+    }
+
+    amrex::Real sum_kappa = 0.0, sum_kappa_w = 0.0;
+    for (int ii = -1; ii <= 1; ii++) {
+      for (int jj = -1; jj <= 1; jj++) {
+        for (int kk = -1; kk <= 1; kk++) {
+          const amrex::Real vnb = vf(i + ii, j + jj, k + kk);
+          const int con = flags(i, j, k).isConnected(ii, jj, kk);
+          sum_kappa += con * vnb;
+          const bool self = (ii == 0) and (jj == 0) and (kk == 0);
+          const int nbr = (self or (vnb < eb_small_vfrac)) ? 0 : con;
+          sum_kappa_w += nbr * vnb * vnb;
+        }
+      }
+    }
+
+    const amrex::Real sum_kappa_inv = 1.0 / sum_kappa;
+    const amrex::Real sum_kappa_w_inv =
+      (sum_kappa_w > 0.0) ? 1.0 / sum_kappa_w : 0.0;
+    for (int ii = -1; ii <= 1; ii++) {
+      for (int jj = -1; jj <= 1; jj++) {
+        for (int kk = -1; kk <= 1; kk++) {
+          const amrex::Real vnb = vf(i + ii, j + jj, k + kk);
+          const int con = flags(i, j, k).isConnected(ii, jj, kk);
+          const bool self = (ii == 0) and (jj == 0) and (kk == 0);
+          const int nbr = (self or (vnb < eb_small_vfrac)) ? 0 : con;
+          sten[L].dnc[ii + 1][jj + 1][kk + 1] = con * vnb * sum_kappa_inv;
+          sten[L].rd[ii + 1][jj + 1][kk + 1] = nbr * vnb * sum_kappa_w_inv;
+          sten[L].rr[ii + 1][jj + 1][kk + 1] =
+            self ? 0.0 : con * vnb * sum_kappa_w_inv;
+        }
+      }
+    }
+  });
+}
+
+// All the components are handled together in each pass over the cut
+// cells, using the weights precomputed by pc_fill_redist_stencil. The
+// passes are separated because each one reads neighbor values written by
+// the previous one. Only the cut cells listed in tile_cut, the indices into
+// sv_ebg/sten of the cut cells in the 2 grow cells of bx, are visited.
 void
 pc_fix_div_and_redistribute(
   const amrex::Box bx,
@@ -278,7 +350,10 @@ pc_fix_div_and_redistribute(
   const amrex::Real eb_small_vfrac,
   const bool levmsk_notcovered,
   const EBBndryGeom* sv_ebg,
+  const EBRedistSten* sten,
   const int Ncut,
+  const int* tile_cut,
+  const int Ntile,
   const amrex::Array4<amrex::EBCellFlag const>& flags,
   const amrex::Array4<const amrex::Real>& f0,
   const amrex::Array4<const amrex::Real>& f1,
@@ -286,7 +361,6 @@ pc_fix_div_and_redistribute(
   const amrex::Real* ebflux,
   const int nebflux,
   const amrex::Array4<const amrex::Real>& vf,
-  const amrex::Array4<const amrex::Real>& W,
   const bool as_crse,
   const bool as_fine,
   const amrex::Array4<const int>& levmsk,
@@ -299,16 +373,16 @@ pc_fix_div_and_redistribute(
   const auto hi = amrex::ubound(bx);
   const amrex::Real volinv = 1.0 / vol;
 
-  for (int n = 0; n < nc; n++) {
-
-    // Recompute conservative divergence, DC, on cut cells...need DC in 2 grow
-    // cells for final result
-    amrex::ParallelFor(Ncut, [=] AMREX_GPU_DEVICE(int L) {
-      const int i = sv_ebg[L].iv[0];
-      const int j = sv_ebg[L].iv[1];
-      const int k = sv_ebg[L].iv[2];
-      if (is_inside(i, j, k, lo, hi, 2)) {
-        const amrex::Real kappa_inv = 1.0 / amrex::max(vf(i, j, k), 1.0e-12);
+  // Recompute conservative divergence, DC, on cut cells...need DC in 2 grow
+  // cells for final result
+  amrex::ParallelFor(Ntile, [=] AMREX_GPU_DEVICE(int t) {
+    const int L = tile_cut[t];
+    const int i = sv_ebg[L].iv[0];
+    const int j = sv_ebg[L].iv[1];
+    const int k = sv_ebg[L].iv[2];
+    if (is_inside(i, j, k, lo, hi, 2)) {
+      const amrex::Real kappa_inv = 1.0 / amrex::max(vf(i, j, k), 1.0e-12);
+      for (int n = 0; n < nc; n++) {
         amrex::Real tmp;
 #ifdef _OPENMP
 #pragma omp atomic read
@@ -319,159 +393,157 @@ pc_fix_div_and_redistribute(
             f1(i, j, k, n) + f2(i, j, k + 1, n) - f2(i, j, k, n) + tmp) *
           volinv * kappa_inv;
       }
-    });
+    }
+  });
 
-    // Compute non-conservative and hybrid divergence, DNC and HD, and
-    // redistribution mass dM in cut cells. Will need in 1 grow cells (see
-    // below), so it depends on having a conservative div in 2 grow cells
-    amrex::Vector<amrex::Real> dM_vec(Ncut, 0.0);
-    amrex::Vector<amrex::Real> HD_vec(Ncut, 0.0);
-    amrex::AsyncArray<amrex::Real> h_dM(dM_vec.data(), dM_vec.size());
-    amrex::AsyncArray<amrex::Real> h_HD(HD_vec.data(), HD_vec.size());
-    amrex::Real* dM = h_dM.data();
-    amrex::Real* HD = h_HD.data();
-    amrex::Gpu::synchronize();
-    amrex::ParallelFor(Ncut, [=] AMREX_GPU_DEVICE(int L) {
-      const int i = sv_ebg[L].iv[0];
-      const int j = sv_ebg[L].iv[1];
-      const int k = sv_ebg[L].iv[2];
-      if (is_inside(i, j, k, lo, hi, 1)) {
-        amrex::Real sum_kappa = 0.0, sum_div = 0.0;
+  // Compute non-conservative and hybrid divergence, DNC and HD, and
+  // redistribution mass dM in cut cells, stored component-innermost. Will
+  // need in 1 grow cells (see below), so it depends on having a
+  // conservative div in 2 grow cells
+  amrex::AsyncArray<amrex::Real> dM_HD(
+    2 * static_cast<std::size_t>(Ntile) * nc);
+  amrex::Real* dM = dM_HD.data();
+  amrex::Real* HD = dM + static_cast<std::size_t>(Ntile) * nc;
+  amrex::ParallelFor(Ntile, [=] AMREX_GPU_DEVICE(int t) {
+    const int L = tile_cut[t];
+    const int i = sv_ebg[L].iv[0];
+    const int j = sv_ebg[L].iv[1];
+    const int k = sv_ebg[L].iv[2];
+    if (is_inside(i, j, k, lo, hi, 1)) {
+      const amrex::Real vfc = vf(i, j, k);
+      const bool small = sv_ebg[L].eb_vfrac < eb_small_vfrac;
+      for (int n = 0; n < nc; n++) {
+        amrex::Real DNC = 0.0;
         for (int ii = -1; ii <= 1; ii++) {
           for (int jj = -1; jj <= 1; jj++) {
             for (int kk = -1; kk <= 1; kk++) {
-              sum_kappa += flags(i, j, k).isConnected(ii, jj, kk) *
-                           vf(i + ii, j + jj, k + kk);
-              sum_div += flags(i, j, k).isConnected(ii, jj, kk) *
-                         vf(i + ii, j + jj, k + kk) *
-                         DC(i + ii, j + jj, k + kk, n);
+              DNC += sten[L].dnc[ii + 1][jj + 1][kk + 1] *
+                     DC(i + ii, j + jj, k + kk, n);
             }
           }
         }
-        const amrex::Real DNC = sum_div / sum_kappa;
-        if (sv_ebg[L].eb_vfrac < eb_small_vfrac) {
-          dM[L] = vf(i, j, k) * DC(i, j, k, n);
-          HD[L] = 0.0;
+        const amrex::Real DCc = DC(i, j, k, n);
+        if (small) {
+          dM[t * nc + n] = vfc * DCc;
+          HD[t * nc + n] = 0.0;
         } else {
-          dM[L] = vf(i, j, k) * (1.0 - vf(i, j, k)) * (DC(i, j, k, n) - DNC);
-          HD[L] = vf(i, j, k) * DC(i, j, k, n) + (1.0 - vf(i, j, k)) * DNC;
+          dM[t * nc + n] = vfc * (1.0 - vfc) * (DCc - DNC);
+          HD[t * nc + n] = vfc * DCc + (1.0 - vfc) * DNC;
         }
       }
-    });
+    }
+  });
 
-    // Now that we finished computing HD and dM everywhere, it is safe to
-    // increment DC to hold HD
-    amrex::ParallelFor(Ncut, [=] AMREX_GPU_DEVICE(int L) {
-      const int i = sv_ebg[L].iv[0];
-      const int j = sv_ebg[L].iv[1];
-      const int k = sv_ebg[L].iv[2];
-      if (is_inside(i, j, k, lo, hi, 1)) {
-        DC(i, j, k, n) = HD[L];
+  // Now that we finished computing HD and dM everywhere, it is safe to
+  // increment DC to hold HD
+  amrex::ParallelFor(Ntile, [=] AMREX_GPU_DEVICE(int t) {
+    const int L = tile_cut[t];
+    const int i = sv_ebg[L].iv[0];
+    const int j = sv_ebg[L].iv[1];
+    const int k = sv_ebg[L].iv[2];
+    if (is_inside(i, j, k, lo, hi, 1)) {
+      for (int n = 0; n < nc; n++) {
+        DC(i, j, k, n) = HD[t * nc + n];
       }
-    });
+    }
+  });
 
-    // Redistribute dM - THIS REQUIRES THAT DC BE GOOD IN 1 GROW CELL
-    const amrex::Real reredistribution_threshold =
-      amrex_eb_get_reredistribution_threshold();
-    amrex::ParallelFor(Ncut, [=] AMREX_GPU_DEVICE(int L) {
-      const int i = sv_ebg[L].iv[0];
-      const int j = sv_ebg[L].iv[1];
-      const int k = sv_ebg[L].iv[2];
-      if (is_inside(i, j, k, lo, hi, 1)) {
-        amrex::Real sum_kappa = 0.0;
-        for (int ii = -1; ii <= 1; ii++) {
-          for (int jj = -1; jj <= 1; jj++) {
-            for (int kk = -1; kk <= 1; kk++) {
-              int nbr = flags(i, j, k).isConnected(ii, jj, kk);
-              if ((ii == 0) and (jj == 0) and (kk == 0)) {
-                nbr = 0;
-              }
-              if (vf(i + ii, j + jj, k + kk) < eb_small_vfrac) {
-                nbr = 0;
+  // Redistribute dM - THIS REQUIRES THAT DC BE GOOD IN 1 GROW CELL
+  const amrex::Real reredistribution_threshold =
+    amrex_eb_get_reredistribution_threshold();
+  amrex::ParallelFor(Ntile, [=] AMREX_GPU_DEVICE(int t) {
+    const int L = tile_cut[t];
+    const int i = sv_ebg[L].iv[0];
+    const int j = sv_ebg[L].iv[1];
+    const int k = sv_ebg[L].iv[2];
+    if (is_inside(i, j, k, lo, hi, 1)) {
+      const amrex::Real* dML = dM + t * nc;
+      for (int ii = -1; ii <= 1; ii++) {
+        for (int jj = -1; jj <= 1; jj++) {
+          for (int kk = -1; kk <= 1; kk++) {
+            const amrex::Real wt = sten[L].rd[ii + 1][jj + 1][kk + 1];
+            if (wt != 0.0) {
+              for (int n = 0; n < nc; n++) {
+                amrex::Gpu::Atomic::Add(
+                  &DC(i + ii, j + jj, k + kk, n), dML[n] * wt);
               }
-              sum_kappa +=
-                nbr * vf(i + ii, j + jj, k + kk) * W(i + ii, j + jj, k + kk);
-            }
-          }
-        }
-        const amrex::Real sum_kappa_inv = 1.0 / sum_kappa;
-        for (int ii = -1; ii <= 1; ii++) {
-          for (int jj = -1; jj <= 1; jj++) {
-            for (int kk = -1; kk <= 1; kk++) {
-              int nbr = flags(i, j, k).isConnected(ii, jj, kk);
-              if ((ii == 0) and (jj == 0) and (kk == 0)) {
-                nbr = 0;
-              }
-              if (vf(i + ii, j + jj, k + kk) < eb_small_vfrac) {
-                nbr = 0;
-              }
-              amrex::Gpu::Atomic::Add(
-                &DC(i + ii, j + jj, k + kk, n),
-                dM[L] * nbr * W(i + ii, j + jj, k + kk) * sum_kappa_inv);
-              // DC(i + ii, j + jj, k + kk, n) += dM[L] * nbr * W(i + ii, j +
-              // jj, k + kk) * sum_kappa_inv;
             }
           }
         }
+      }
 
-        // re redistribution book keeping
-        bool as_crse_crse_cell = false;
-        bool as_crse_covered_cell = false;
-        if (as_crse) {
-          as_crse_crse_cell =
-            is_inside(i, j, k, lo, hi) and
-            (rr_flag_crse(i, j, k) == amrex_yafluxreg_crse_fine_boundary_cell);
-          as_crse_covered_cell =
-            rr_flag_crse(i, j, k) == amrex_yafluxreg_fine_cell;
-        }
+      // re redistribution book keeping
+      bool as_crse_crse_cell = false;
+      bool as_crse_covered_cell = false;
+      if (as_crse) {
+        as_crse_crse_cell =
+          is_inside(i, j, k, lo, hi) and
+          (rr_flag_crse(i, j, k) == amrex_yafluxreg_crse_fine_boundary_cell);
+        as_crse_covered_cell =
+          rr_flag_crse(i, j, k) == amrex_yafluxreg_fine_cell;
+      }
 
-        bool as_fine_valid_cell = false; // valid cells near box boundary
-        bool as_fine_ghost_cell =
-          false; // ghost cells just outside valid region
-        if (as_fine) {
-          as_fine_valid_cell = is_inside(i, j, k, lo, hi);
-          as_fine_ghost_cell =
-            (levmsk(i, j, k) ==
-             levmsk_notcovered); // not covered by other grids
-        }
+      bool as_fine_valid_cell = false; // valid cells near box boundary
+      bool as_fine_ghost_cell = false; // ghost cells just outside valid region
+      if (as_fine) {
+        as_fine_valid_cell = is_inside(i, j, k, lo, hi);
+        as_fine_ghost_cell =
+          (levmsk(i, j, k) ==
+           levmsk_notcovered); // not covered by other grids
+      }
 
-        for (int ii = -1; ii <= 1; ii++) {
-          for (int jj = -1; jj <= 1; jj++) {
-            for (int kk = -1; kk <= 1; kk++) {
-              if (
-                ((ii != 0) || (jj != 0) || (kk != 0)) and
-                flags(i, j, k).isConnected(ii, jj, kk)) {
-
-                const int iii = i + ii;
-                const int jjj = j + jj;
-                const int kkk = k + kk;
-
-                const amrex::Real drho =
-                  dM[L] * sum_kappa_inv * W(iii, jjj, kkk);
-                const bool valid_dst_cell = is_inside(iii, jjj, kkk, lo, hi);
-
-                if (
-                  (as_crse_crse_cell) and
-                  (rr_flag_crse(iii, jjj, kkk) == amrex_yafluxreg_fine_cell) and
-                  (vf(i, j, k) > reredistribution_threshold)) {
+      if (
+        !(as_crse_crse_cell or as_crse_covered_cell or as_fine_valid_cell or
+          as_fine_ghost_cell)) {
+        return;
+      }
+
+      for (int ii = -1; ii <= 1; ii++) {
+        for (int jj = -1; jj <= 1; jj++) {
+          for (int kk = -1; kk <= 1; kk++) {
+            if (
+              ((ii != 0) || (jj != 0) || (kk != 0)) and
+              flags(i, j, k).isConnected(ii, jj, kk)) {
+
+              const int iii = i + ii;
+              const int jjj = j + jj;
+              const int kkk = k + kk;
+
+              const amrex::Real wt = sten[L].rr[ii + 1][jj + 1][kk + 1];
+              const bool valid_dst_cell = is_inside(iii, jjj, kkk, lo, hi);
+
+              const bool rr_crse_crse =
+                (as_crse_crse_cell) and
+                (rr_flag_crse(iii, jjj, kkk) == amrex_yafluxreg_fine_cell) and
+                (vf(i, j, k) > reredistribution_threshold);
+              const bool rr_crse_covered =
+                (as_crse_covered_cell) and (valid_dst_cell) and
+                (rr_flag_crse(iii, jjj, kkk) ==
+                 amrex_yafluxreg_crse_fine_boundary_cell) and
+                (vf(iii, jjj, kkk) > reredistribution_threshold);
+              const bool rr_fine_valid =
+                (as_fine_valid_cell) and (!valid_dst_cell);
+              const bool rr_fine_ghost =
+                (as_fine_ghost_cell) and (valid_dst_cell);
+
+              for (int n = 0; n < nc; n++) {
+                const amrex::Real drho = dML[n] * wt;
+
+                if (rr_crse_crse) {
                   rr_drho_crse(i, j, k, n) +=
                     dt * drho * (vf(iii, jjj, kkk) / vf(i, j, k));
                 }
 
-                if (
-                  (as_crse_covered_cell) and (valid_dst_cell) and
-                  (rr_flag_crse(iii, jjj, kkk) ==
-                   amrex_yafluxreg_crse_fine_boundary_cell) and
-                  (vf(iii, jjj, kkk) > reredistribution_threshold)) {
+                if (rr_crse_covered) {
                   // the recipient is a crse/fine boundary cell
                   rr_drho_crse(iii, jjj, kkk, n) -= dt * drho;
                 }
 
-                if ((as_fine_valid_cell) and (!valid_dst_cell)) {
+                if (rr_fine_valid) {
                   dm_as_fine(iii, jjj, kkk, n) += dt * drho * vf(iii, jjj, kkk);
                 }
 
-                if ((as_fine_ghost_cell) and (valid_dst_cell)) {
+                if (rr_fine_ghost) {
                   dm_as_fine(i, j, k, n) -= dt * drho * vf(iii, jjj, kkk);
                 }
               }
@@ -479,8 +551,8 @@ pc_fix_div_and_redistribute(
           }
         }
       }
-    });
-  }
+    }
+  });
 }
 
 void
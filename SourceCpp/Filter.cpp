@@ -485,25 +485,48 @@ Filter::apply_filter(
   const int ncomp)
 {
 
-  const auto q = in.array();
-  auto qh = out.array();
-  setC(box, nstart, ncnt, qh, 0.0);
+  // The filter weights are a tensor product of the 1D weights, so the
+  // filter is applied as one 1D sweep per direction: (2*ngrow+1) operations
+  // per point and direction instead of (2*ngrow+1)^3. Each sweep but the
+  // last writes into a scratch fab covering the box grown in the directions
+  // that remain to be filtered.
   const amrex::AsyncArray<amrex::Real> weights(
     _weights.data(), _weights.size());
   const amrex::Real* w = weights.data();
-
   const int captured_ngrow = _ngrow;
-  amrex::ParallelFor(
-    box, ncnt - nstart,
-    [=] AMREX_GPU_DEVICE(int i, int j, int k, int nc) noexcept {
-      for (int n = -captured_ngrow; n <= captured_ngrow; n++) {
-        for (int m = -captured_ngrow; m <= captured_ngrow; m++) {
-          for (int l = -captured_ngrow; l <= captured_ngrow; l++) {
-            qh(i, j, k, nc + nstart) +=
-              w[l + captured_ngrow] * w[m + captured_ngrow] *
-              w[n + captured_ngrow] * q(i + l, j + m, k + n, nc);
-          }
+  const int nc_tot = ncnt - nstart;
+
+  amrex::FArrayBox tmp[2];
+  amrex::Elixir tmp_eli[2];
+  amrex::Array4<const amrex::Real> src = in.const_array();
+  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
+    amrex::Box sbox(box);
+    for (int d = dir + 1; d < AMREX_SPACEDIM; d++) {
+      sbox.grow(d, _ngrow);
+    }
+    const amrex::Dim3 off = amrex::IntVect::TheDimensionVector(dir).dim3();
+
+    amrex::Array4<amrex::Real> dst;
+    int dst_comp = 0;
+    if (dir == AMREX_SPACEDIM - 1) {
+      dst = out.array();
+      dst_comp = nstart;
+    } else {
+      tmp[dir % 2].resize(sbox, nc_tot);
+      tmp_eli[dir % 2] = tmp[dir % 2].elixir();
+      dst = tmp[dir % 2].array();
+    }
+
+    amrex::ParallelFor(
+      sbox, nc_tot, [=] AMREX_GPU_DEVICE(int i, int j, int k, int nc) noexcept {
+        amrex::Real sum = 0.0;
+        for (int l = -captured_ngrow; l <= captured_ngrow; l++) {
+          sum += w[l + captured_ngrow] *
+                 src(i + l * off.x, j + l * off.y, k + l * off.z, nc);
         }
-      }
-    });
+        dst(i, j, k, nc + dst_comp) = sum;
+      });
+
+    src = dst;
+  }
 }
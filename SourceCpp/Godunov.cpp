@@ -1,10 +1,13 @@
 #include "Godunov.H"
 #include "PLM.H"
 #include "PPM.H"
+#include "ScratchArena.H"
 
+namespace {
 // Host function to call gpu hydro functions
+template <int solver>
 void
-pc_umeth_3D(
+umeth_3D(
   amrex::Box const& bx,
   const int* bclo,
   const int* bchi,
@@ -31,6 +34,7 @@ pc_umeth_3D(
   const int ppm_type,
   const int use_flattening)
 {
+  ScratchArena& scratch = ScratchArena::get();
   amrex::Real const dx = del[0];
   amrex::Real const dy = del[1];
   amrex::Real const dz = del[2];
@@ -62,8 +66,8 @@ pc_umeth_3D(
   // X data
   int cdir = 0;
   const amrex::Box& xmbx = growHi(bxg2, cdir, 1);
-  amrex::FArrayBox qxm(xmbx, QVAR);
-  amrex::FArrayBox qxp(bxg2, QVAR);
+  amrex::FArrayBox qxm = scratch.fab(xmbx, QVAR);
+  amrex::FArrayBox qxp = scratch.fab(bxg2, QVAR);
   amrex::Elixir qxmeli = qxm.elixir();
   amrex::Elixir qxpeli = qxp.elixir();
   auto const& qxmarr = qxm.array();
@@ -73,8 +77,8 @@ pc_umeth_3D(
   cdir = 1;
   const amrex::Box& yflxbx = surroundingNodes(grow(bxg2, cdir, -1), cdir);
   const amrex::Box& ymbx = growHi(bxg2, cdir, 1);
-  amrex::FArrayBox qym(ymbx, QVAR);
-  amrex::FArrayBox qyp(bxg2, QVAR);
+  amrex::FArrayBox qym = scratch.fab(ymbx, QVAR);
+  amrex::FArrayBox qyp = scratch.fab(bxg2, QVAR);
   amrex::Elixir qymeli = qym.elixir();
   amrex::Elixir qypeli = qyp.elixir();
   auto const& qymarr = qym.array();
@@ -84,8 +88,8 @@ pc_umeth_3D(
   cdir = 2;
   const amrex::Box& zmbx = growHi(bxg2, cdir, 1);
   const amrex::Box& zflxbx = surroundingNodes(grow(bxg2, cdir, -1), cdir);
-  amrex::FArrayBox qzm(zmbx, QVAR);
-  amrex::FArrayBox qzp(bxg2, QVAR);
+  amrex::FArrayBox qzm = scratch.fab(zmbx, QVAR);
+  amrex::FArrayBox qzp = scratch.fab(bxg2, QVAR);
   amrex::Elixir qzmeli = qzm.elixir();
   amrex::Elixir qzpeli = qzp.elixir();
   auto const& qzmarr = qzm.array();
@@ -136,63 +140,60 @@ pc_umeth_3D(
   // method X initial fluxes
   cdir = 0;
   const amrex::Box& xflxbx = surroundingNodes(grow(bxg2, cdir, -1), cdir);
-  amrex::FArrayBox fx(xflxbx, NVAR);
+  amrex::FArrayBox fx = scratch.fab(xflxbx, NVAR);
   amrex::Elixir fxeli = fx.elixir();
   auto const& fxarr = fx.array();
-  amrex::FArrayBox qgdx(xflxbx, NGDNV);
+  amrex::FArrayBox qgdx = scratch.fab(xflxbx, NGDNV);
   amrex::Elixir qgdxeli = qgdx.elixir();
   auto const& gdtempx = qgdx.array();
   amrex::ParallelFor(
     xflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      pc_cmpflx(
-        i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtempx, qaux,
-        cdir);
+      pc_cmpflx<solver, 0>(
+        i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtempx, qaux);
     });
 
   // Y initial fluxes
   cdir = 1;
-  amrex::FArrayBox fy(yflxbx, NVAR);
+  amrex::FArrayBox fy = scratch.fab(yflxbx, NVAR);
   amrex::Elixir fyeli = fy.elixir();
   auto const& fyarr = fy.array();
-  amrex::FArrayBox qgdy(yflxbx, NGDNV);
+  amrex::FArrayBox qgdy = scratch.fab(yflxbx, NGDNV);
   amrex::Elixir qgdyeli = qgdy.elixir();
   auto const& gdtempy = qgdy.array();
   amrex::ParallelFor(
     yflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      pc_cmpflx(
-        i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, gdtempy, qaux,
-        cdir);
+      pc_cmpflx<solver, 1>(
+        i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, gdtempy, qaux);
     });
 
   // Z initial fluxes
   cdir = 2;
-  amrex::FArrayBox fz(zflxbx, NVAR);
+  amrex::FArrayBox fz = scratch.fab(zflxbx, NVAR);
   amrex::Elixir fzeli = fz.elixir();
   auto const& fzarr = fz.array();
-  amrex::FArrayBox qgdz(zflxbx, NGDNV);
+  amrex::FArrayBox qgdz = scratch.fab(zflxbx, NGDNV);
   amrex::Elixir qgdzeli = qgdz.elixir();
   auto const& gdtempz = qgdz.array();
   amrex::ParallelFor(
     zflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      pc_cmpflx(
-        i, j, k, bclz, bchz, dlz, dhz, qzmarr, qzparr, fzarr, gdtempz, qaux,
-        cdir);
+      pc_cmpflx<solver, 2>(
+        i, j, k, bclz, bchz, dlz, dhz, qzmarr, qzparr, fzarr, gdtempz, qaux);
     });
 
   // X interface corrections
   cdir = 0;
   const amrex::Box& txbx = grow(bxg1, cdir, 1);
   const amrex::Box& txbxm = growHi(txbx, cdir, 1);
-  amrex::FArrayBox qxym(txbxm, QVAR);
+  amrex::FArrayBox qxym = scratch.fab(txbxm, QVAR);
   amrex::Elixir qxymeli = qxym.elixir();
-  amrex::FArrayBox qxyp(txbx, QVAR);
+  amrex::FArrayBox qxyp = scratch.fab(txbx, QVAR);
   amrex::Elixir qxypeli = qxyp.elixir();
   auto const& qmxy = qxym.array();
   auto const& qpxy = qxyp.array();
 
-  amrex::FArrayBox qxzm(txbxm, QVAR);
+  amrex::FArrayBox qxzm = scratch.fab(txbxm, QVAR);
   amrex::Elixir qxzmeli = qxzm.elixir();
-  amrex::FArrayBox qxzp(txbx, QVAR);
+  amrex::FArrayBox qxzp = scratch.fab(txbx, QVAR);
   amrex::Elixir qxzpeli = qxzp.elixir();
   auto const& qmxz = qxzm.array();
   auto const& qpxz = qxzp.array();
@@ -207,10 +208,10 @@ pc_umeth_3D(
   });
 
   const amrex::Box& txfxbx = surroundingNodes(bxg1, cdir);
-  amrex::FArrayBox fluxxy(txfxbx, NVAR);
-  amrex::FArrayBox fluxxz(txfxbx, NVAR);
-  amrex::FArrayBox gdvxyfab(txfxbx, NGDNV);
-  amrex::FArrayBox gdvxzfab(txfxbx, NGDNV);
+  amrex::FArrayBox fluxxy = scratch.fab(txfxbx, NVAR);
+  amrex::FArrayBox fluxxz = scratch.fab(txfxbx, NVAR);
+  amrex::FArrayBox gdvxyfab = scratch.fab(txfxbx, NGDNV);
+  amrex::FArrayBox gdvxzfab = scratch.fab(txfxbx, NGDNV);
   amrex::Elixir fluxxyeli = fluxxy.elixir(), gdvxyeli = gdvxyfab.elixir();
   amrex::Elixir fluxxzeli = fluxxz.elixir(), gdvxzeli = gdvxzfab.elixir();
 
@@ -223,11 +224,11 @@ pc_umeth_3D(
   amrex::ParallelFor(
     txfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       // X|Y
-      pc_cmpflx(
-        i, j, k, bclx, bchx, dlx, dhx, qmxy, qpxy, flxy, qxy, qaux, cdir);
+      pc_cmpflx<solver, 0>(
+        i, j, k, bclx, bchx, dlx, dhx, qmxy, qpxy, flxy, qxy, qaux);
       // X|Z
-      pc_cmpflx(
-        i, j, k, bclx, bchx, dlx, dhx, qmxz, qpxz, flxz, qxz, qaux, cdir);
+      pc_cmpflx<solver, 0>(
+        i, j, k, bclx, bchx, dlx, dhx, qmxz, qpxz, flxz, qxz, qaux);
     });
 
   qxymeli.clear();
@@ -239,10 +240,10 @@ pc_umeth_3D(
   cdir = 1;
   const amrex::Box& tybx = grow(bxg1, cdir, 1);
   const amrex::Box& tybxm = growHi(tybx, cdir, 1);
-  amrex::FArrayBox qyxm(tybxm, QVAR);
-  amrex::FArrayBox qyxp(tybx, QVAR);
-  amrex::FArrayBox qyzm(tybxm, QVAR);
-  amrex::FArrayBox qyzp(tybx, QVAR);
+  amrex::FArrayBox qyxm = scratch.fab(tybxm, QVAR);
+  amrex::FArrayBox qyxp = scratch.fab(tybx, QVAR);
+  amrex::FArrayBox qyzm = scratch.fab(tybxm, QVAR);
+  amrex::FArrayBox qyzp = scratch.fab(tybx, QVAR);
   amrex::Elixir qyxmeli = qyxm.elixir(), qyxpeli = qyxp.elixir();
   amrex::Elixir qyzmeli = qyzm.elixir(), qyzpeli = qyzp.elixir();
   auto const& qmyx = qyxm.array();
@@ -264,10 +265,10 @@ pc_umeth_3D(
 
   // Riemann problem Y|X Y|Z
   const amrex::Box& tyfxbx = surroundingNodes(bxg1, cdir);
-  amrex::FArrayBox fluxyx(tyfxbx, NVAR);
-  amrex::FArrayBox fluxyz(tyfxbx, NVAR);
-  amrex::FArrayBox gdvyxfab(tyfxbx, NGDNV);
-  amrex::FArrayBox gdvyzfab(tyfxbx, NGDNV);
+  amrex::FArrayBox fluxyx = scratch.fab(tyfxbx, NVAR);
+  amrex::FArrayBox fluxyz = scratch.fab(tyfxbx, NVAR);
+  amrex::FArrayBox gdvyxfab = scratch.fab(tyfxbx, NGDNV);
+  amrex::FArrayBox gdvyzfab = scratch.fab(tyfxbx, NGDNV);
   amrex::Elixir fluxyxeli = fluxyx.elixir(), gdvyxeli = gdvyxfab.elixir();
   amrex::Elixir fluxyzeli = fluxyz.elixir(), gdvyzeli = gdvyzfab.elixir();
 
@@ -279,11 +280,11 @@ pc_umeth_3D(
   amrex::ParallelFor(
     tyfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       // Y|X
-      pc_cmpflx(
-        i, j, k, bcly, bchy, dly, dhy, qmyx, qpyx, flyx, qyx, qaux, cdir);
+      pc_cmpflx<solver, 1>(
+        i, j, k, bcly, bchy, dly, dhy, qmyx, qpyx, flyx, qyx, qaux);
       // Y|Z
-      pc_cmpflx(
-        i, j, k, bcly, bchy, dly, dhy, qmyz, qpyz, flyz, qyz, qaux, cdir);
+      pc_cmpflx<solver, 1>(
+        i, j, k, bcly, bchy, dly, dhy, qmyz, qpyz, flyz, qyz, qaux);
     });
 
   qyxmeli.clear();
@@ -295,10 +296,10 @@ pc_umeth_3D(
   cdir = 2;
   const amrex::Box& tzbx = grow(bxg1, cdir, 1);
   const amrex::Box& tzbxm = growHi(tzbx, cdir, 1);
-  amrex::FArrayBox qzxm(tzbxm, QVAR);
-  amrex::FArrayBox qzxp(tzbx, QVAR);
-  amrex::FArrayBox qzym(tzbxm, QVAR);
-  amrex::FArrayBox qzyp(tzbx, QVAR);
+  amrex::FArrayBox qzxm = scratch.fab(tzbxm, QVAR);
+  amrex::FArrayBox qzxp = scratch.fab(tzbx, QVAR);
+  amrex::FArrayBox qzym = scratch.fab(tzbxm, QVAR);
+  amrex::FArrayBox qzyp = scratch.fab(tzbx, QVAR);
   amrex::Elixir qzxmeli = qzxm.elixir(), qzxpeli = qzxp.elixir();
   amrex::Elixir qzymeli = qzym.elixir(), qzypeli = qzyp.elixir();
 
@@ -323,10 +324,10 @@ pc_umeth_3D(
 
   // Riemann problem Z|X Z|Y
   const amrex::Box& tzfxbx = surroundingNodes(bxg1, cdir);
-  amrex::FArrayBox fluxzx(tzfxbx, NVAR);
-  amrex::FArrayBox fluxzy(tzfxbx, NVAR);
-  amrex::FArrayBox gdvzxfab(tzfxbx, NGDNV);
-  amrex::FArrayBox gdvzyfab(tzfxbx, NGDNV);
+  amrex::FArrayBox fluxzx = scratch.fab(tzfxbx, NVAR);
+  amrex::FArrayBox fluxzy = scratch.fab(tzfxbx, NVAR);
+  amrex::FArrayBox gdvzxfab = scratch.fab(tzfxbx, NGDNV);
+  amrex::FArrayBox gdvzyfab = scratch.fab(tzfxbx, NGDNV);
   amrex::Elixir fluxzxeli = fluxzx.elixir(), gdvzxeli = gdvzxfab.elixir();
   amrex::Elixir fluxzyeli = fluxzy.elixir(), gdvzyeli = gdvzyfab.elixir();
 
@@ -338,11 +339,11 @@ pc_umeth_3D(
   amrex::ParallelFor(
     tzfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
       // Z|X
-      pc_cmpflx(
-        i, j, k, bclz, bchz, dlz, dhz, qmzx, qpzx, flzx, qzx, qaux, cdir);
+      pc_cmpflx<solver, 2>(
+        i, j, k, bclz, bchz, dlz, dhz, qmzx, qpzx, flzx, qzx, qaux);
       // Z|Y
-      pc_cmpflx(
-        i, j, k, bclz, bchz, dlz, dhz, qmzy, qpzy, flzy, qzy, qaux, cdir);
+      pc_cmpflx<solver, 2>(
+        i, j, k, bclz, bchz, dlz, dhz, qmzy, qpzy, flzy, qzy, qaux);
     });
 
   qzxmeli.clear();
@@ -351,8 +352,8 @@ pc_umeth_3D(
   qzypeli.clear();
 
   // Temp Fabs for Final Fluxes
-  amrex::FArrayBox qmfab(bxg2, QVAR);
-  amrex::FArrayBox qpfab(bxg1, QVAR);
+  amrex::FArrayBox qmfab = scratch.fab(bxg2, QVAR);
+  amrex::FArrayBox qpfab = scratch.fab(bxg1, QVAR);
   amrex::Elixir qmeli = qmfab.elixir();
   amrex::Elixir qpeli = qpfab.elixir();
   auto const& qm = qmfab.array();
@@ -376,7 +377,7 @@ pc_umeth_3D(
   qxpeli.clear();
   // Final X flux
   amrex::ParallelFor(xfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-    pc_cmpflx(i, j, k, bclx, bchx, dlx, dhx, qm, qp, flx1, q1, qaux, cdir);
+    pc_cmpflx<solver, 0>(i, j, k, bclx, bchx, dlx, dhx, qm, qp, flx1, q1, qaux);
   });
 
   // Y | X&Z
@@ -397,7 +398,7 @@ pc_umeth_3D(
   qypeli.clear();
   // Final Y flux
   amrex::ParallelFor(yfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-    pc_cmpflx(i, j, k, bcly, bchy, dly, dhy, qm, qp, flx2, q2, qaux, cdir);
+    pc_cmpflx<solver, 1>(i, j, k, bcly, bchy, dly, dhy, qm, qp, flx2, q2, qaux);
   });
 
   // Z | X&Y
@@ -418,7 +419,7 @@ pc_umeth_3D(
   qzpeli.clear();
   // Final Z flux
   amrex::ParallelFor(zfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-    pc_cmpflx(i, j, k, bclz, bchz, dlz, dhz, qm, qp, flx3, q3, qaux, cdir);
+    pc_cmpflx<solver, 2>(i, j, k, bclz, bchz, dlz, dhz, qm, qp, flx3, q3, qaux);
   });
 
   qmeli.clear();
@@ -430,8 +431,9 @@ pc_umeth_3D(
   });
 }
 
+template <int solver>
 void
-pc_umeth_2D(
+umeth_2D(
   amrex::Box const& bx,
   const int* bclo,
   const int* bchi,
@@ -455,6 +457,7 @@ pc_umeth_2D(
   const int ppm_type,
   const int use_flattening)
 {
+  ScratchArena& scratch = ScratchArena::get();
 #if AMREX_SPACEDIM == 2
   {
     const int use_flattening_loc = use_flattening;
@@ -480,8 +483,8 @@ pc_umeth_2D(
     int cdir = 0;
     const amrex::Box& xslpbx = grow(bxg1, cdir, 1);
     const amrex::Box& xmbx = growHi(xslpbx, cdir, 1);
-    amrex::FArrayBox qxm(xmbx, QVAR);
-    amrex::FArrayBox qxp(xslpbx, QVAR);
+    amrex::FArrayBox qxm = scratch.fab(xmbx, QVAR);
+    amrex::FArrayBox qxp = scratch.fab(xslpbx, QVAR);
     amrex::Elixir qxmeli = qxm.elixir();
     amrex::Elixir qxpeli = qxp.elixir();
     auto const& qxmarr = qxm.array();
@@ -492,8 +495,8 @@ pc_umeth_2D(
     const amrex::Box& yflxbx = surroundingNodes(bxg1, cdir);
     const amrex::Box& yslpbx = grow(bxg1, cdir, 1);
     const amrex::Box& ymbx = growHi(yslpbx, cdir, 1);
-    amrex::FArrayBox qym(ymbx, QVAR);
-    amrex::FArrayBox qyp(yslpbx, QVAR);
+    amrex::FArrayBox qym = scratch.fab(ymbx, QVAR);
+    amrex::FArrayBox qyp = scratch.fab(yslpbx, QVAR);
     amrex::Elixir qymeli = qym.elixir();
     amrex::Elixir qypeli = qyp.elixir();
     auto const& qymarr = qym.array();
@@ -521,36 +524,35 @@ pc_umeth_2D(
     // method X initial fluxes
     cdir = 0;
     const amrex::Box& xflxbx = surroundingNodes(bxg1, cdir);
-    amrex::FArrayBox fx(xflxbx, NVAR);
+    amrex::FArrayBox fx = scratch.fab(xflxbx, NVAR);
     amrex::Elixir fxeli = fx.elixir();
     auto const& fxarr = fx.array();
-    amrex::FArrayBox qgdx(bxg2, NGDNV);
+    amrex::FArrayBox qgdx = scratch.fab(bxg2, NGDNV);
     amrex::Elixir qgdxeli = qgdx.elixir();
     auto const& gdtemp = qgdx.array();
     amrex::ParallelFor(
       xflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-        pc_cmpflx(
-          i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtemp, qaux,
-          cdir);
+        pc_cmpflx<solver, 0>(
+          i, j, k, bclx, bchx, dlx, dhx, qxmarr, qxparr, fxarr, gdtemp, qaux);
       });
 
     // Y initial fluxes
     cdir = 1;
-    amrex::FArrayBox fy(yflxbx, NVAR);
+    amrex::FArrayBox fy = scratch.fab(yflxbx, NVAR);
     amrex::Elixir fyeli = fy.elixir();
     auto const& fyarr = fy.array();
     amrex::ParallelFor(
       yflxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-        pc_cmpflx(
-          i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, q2, qaux, cdir);
+        pc_cmpflx<solver, 1>(
+          i, j, k, bcly, bchy, dly, dhy, qymarr, qyparr, fyarr, q2, qaux);
       });
 
     // X interface corrections
     cdir = 0;
     const amrex::Box& tybx = grow(bx, cdir, 1);
-    amrex::FArrayBox qm(bxg2, QVAR);
+    amrex::FArrayBox qm = scratch.fab(bxg2, QVAR);
     amrex::Elixir qmeli = qm.elixir();
-    amrex::FArrayBox qp(bxg1, QVAR);
+    amrex::FArrayBox qp = scratch.fab(bxg1, QVAR);
     amrex::Elixir qpeli = qp.elixir();
     auto const& qmarr = qm.array();
     auto const& qparr = qp.array();
@@ -570,8 +572,8 @@ pc_umeth_2D(
     // Final Riemann problem X
     amrex::ParallelFor(
       xfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-        pc_cmpflx(
-          i, j, k, bclx, bchx, dlx, dhx, qmarr, qparr, flx1, q1, qaux, cdir);
+        pc_cmpflx<solver, 0>(
+          i, j, k, bclx, bchx, dlx, dhx, qmarr, qparr, flx1, q1, qaux);
       });
 
     // Y interface corrections
@@ -592,8 +594,8 @@ pc_umeth_2D(
     const amrex::Box& yfxbx = surroundingNodes(bx, cdir);
     amrex::ParallelFor(
       yfxbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-        pc_cmpflx(
-          i, j, k, bcly, bchy, dly, dhy, qmarr, qparr, flx2, q2, qaux, cdir);
+        pc_cmpflx<solver, 1>(
+          i, j, k, bcly, bchy, dly, dhy, qmarr, qparr, flx2, q2, qaux);
       });
 
     // Construct p div{U}
@@ -603,3 +605,70 @@ pc_umeth_2D(
   }
 #endif // AMREX_SPACEDIM == 2
 }
+
+} // namespace
+
+void
+pc_umeth_3D(
+  amrex::Box const& bx,
+  const int* bclo,
+  const int* bchi,
+  const int* domlo,
+  const int* domhi,
+  amrex::Array4<const amrex::Real> const& q,
+  amrex::Array4<const amrex::Real> const& qaux,
+  amrex::Array4<const amrex::Real> const& srcQ,
+  amrex::Array4<amrex::Real> const& flx1,
+  amrex::Array4<amrex::Real> const& flx2,
+  amrex::Array4<amrex::Real> const& flx3,
+  amrex::Array4<amrex::Real> const& q1,
+  amrex::Array4<amrex::Real> const& q2,
+  amrex::Array4<amrex::Real> const& q3,
+  amrex::Array4<const amrex::Real> const& a1,
+  amrex::Array4<const amrex::Real> const& a2,
+  amrex::Array4<const amrex::Real> const& a3,
+  amrex::Array4<amrex::Real> const& pdivu,
+  amrex::Array4<const amrex::Real> const& vol,
+  const amrex::Real* del,
+  const amrex::Real dt,
+  const int ppm_type,
+  const int use_flattening,
+  const int riemann_solver)
+{
+  pc_riemann_dispatch(riemann_solver, [&](auto rs) {
+    umeth_3D<decltype(rs)::value>(
+      bx, bclo, bchi, domlo, domhi, q, qaux, srcQ, flx1, flx2, flx3, q1, q2, q3,
+      a1, a2, a3, pdivu, vol, del, dt, ppm_type, use_flattening);
+  });
+}
+
+void
+pc_umeth_2D(
+  amrex::Box const& bx,
+  const int* bclo,
+  const int* bchi,
+  const int* domlo,
+  const int* domhi,
+  amrex::Array4<const amrex::Real> const& q,
+  amrex::Array4<const amrex::Real> const& qaux,
+  amrex::Array4<const amrex::Real> const& srcQ,
+  amrex::Array4<amrex::Real> const& flx1,
+  amrex::Array4<amrex::Real> const& flx2,
+  amrex::Array4<amrex::Real> const& q1,
+  amrex::Array4<amrex::Real> const& q2,
+  amrex::Array4<const amrex::Real> const& a1,
+  amrex::Array4<const amrex::Real> const& a2,
+  amrex::Array4<amrex::Real> const& pdivu,
+  amrex::Array4<const amrex::Real> const& vol,
+  const amrex::Real* del,
+  const amrex::Real dt,
+  const int ppm_type,
+  const int use_flattening,
+  const int riemann_solver)
+{
+  pc_riemann_dispatch(riemann_solver, [&](auto rs) {
+    umeth_2D<decltype(rs)::value>(
+      bx, bclo, bchi, domlo, domhi, q, qaux, srcQ, flx1, flx2, q1, q2, a1, a2,
+      pdivu, vol, del, dt, ppm_type, use_flattening);
+  });
+}
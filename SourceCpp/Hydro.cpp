@@ -1,4 +1,5 @@
 #include "Hydro.H"
+#include "ScratchArena.H"
 
 /**
  *  Set up the source terms to go into the hydro.
@@ -104,7 +105,9 @@ PeleC::construct_hydro_source(
       const int* domain_lo = geom.Domain().loVect();
       const int* domain_hi = geom.Domain().hiVect();
 
-      // Temporary Fabs needed for Hydro Computation
+      // Temporary Fabs needed for Hydro Computation are drawn from the
+      // thread's scratch arena, which is reset after each tile
+      ScratchArena& scratch = ScratchArena::get();
       for (amrex::MFIter mfi(S_new, amrex::TilingIfNotGPU()); mfi.isValid();
            ++mfi) {
 
@@ -118,7 +121,7 @@ PeleC::construct_hydro_source(
         amrex::Elixir flux_eli[AMREX_SPACEDIM];
         for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
           const amrex::Box& efbx = surroundingNodes(fbx, dir);
-          flux[dir].resize(efbx, NVAR);
+          flux[dir] = scratch.fab(efbx, NVAR);
           flux_eli[dir] = flux[dir].elixir();
         }
 
@@ -126,7 +129,9 @@ PeleC::construct_hydro_source(
         auto const& hyd_src = hydro_source.array(mfi);
 
         // Resize Temporary Fabs
-        amrex::FArrayBox q(qbx, QVAR), qaux(qbx, NQAUX), src_q(qbx, QVAR);
+        amrex::FArrayBox q = scratch.fab(qbx, QVAR);
+        amrex::FArrayBox qaux = scratch.fab(qbx, NQAUX);
+        amrex::FArrayBox src_q = scratch.fab(qbx, QVAR);
         // Use Elixir Construct to steal the Fabs metadata
         amrex::Elixir qeli = q.elixir();
         amrex::Elixir qauxeli = qaux.elixir();
@@ -215,7 +220,8 @@ PeleC::construct_hydro_source(
         pc_umdrv(
           is_finest_level, time, bx, domain_lo, domain_hi, phys_bc.lo(),
           phys_bc.hi(), s, hyd_src, qarr, qauxar, srcqarr, dx, dt, ppm_type,
-          use_flattening, flx_arr, a, volume.array(mfi), cflLoc);
+          use_flattening, riemann_solver, flx_arr, a, volume.array(mfi),
+          cflLoc);
         BL_PROFILE_VAR_STOP(purm);
 
         BL_PROFILE_VAR("courno + flux reg", crno);
@@ -225,7 +231,7 @@ PeleC::construct_hydro_source(
         if (use_explicit_filter) {
           for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
             const amrex::Box& bxtmp = amrex::surroundingNodes(bx, dir);
-            amrex::FArrayBox filtered_flux(bxtmp, NVAR);
+            amrex::FArrayBox filtered_flux = scratch.fab(bxtmp, NVAR);
             amrex::Elixir filtered_flux_eli = filtered_flux.elixir();
             les_filter.apply_filter(
               bxtmp, flux[dir], filtered_flux, Density, NVAR);
@@ -235,7 +241,7 @@ PeleC::construct_hydro_source(
               bxtmp, flux[dir].nComp(), filtered_flux.array(), flx_arr[dir]);
           }
 
-          amrex::FArrayBox filtered_source_out(bx, NVAR);
+          amrex::FArrayBox filtered_source_out = scratch.fab(bx, NVAR);
           amrex::Elixir filtered_source_out_eli = filtered_source_out.elixir();
           les_filter.apply_filter(
             bx, hydro_source[mfi], filtered_source_out, Density, NVAR);
@@ -269,6 +275,8 @@ PeleC::construct_hydro_source(
           }
         }
         BL_PROFILE_VAR_STOP(crno);
+
+        scratch.reset();
       } // MFIter loop
     }   // end of OMP parallel region
 
@@ -349,6 +357,7 @@ pc_umdrv(
   const amrex::Real dt,
   const int ppm_type,
   const int use_flattening,
+  const int riemann_solver,
   const amrex::GpuArray<const amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx,
   const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
     a,
@@ -356,20 +365,21 @@ pc_umdrv(
   amrex::Real cflLoc)
 {
   //  Set Up for Hydro Flux Calculations
+  ScratchArena& scratch = ScratchArena::get();
   auto const& bxg2 = grow(bx, 2);
   amrex::FArrayBox qec[AMREX_SPACEDIM];
   amrex::Elixir qec_eli[AMREX_SPACEDIM];
   for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
     const amrex::Box eboxes = amrex::surroundingNodes(bxg2, dir);
-    qec[dir].resize(eboxes, NGDNV);
+    qec[dir] = scratch.fab(eboxes, NGDNV);
     qec_eli[dir] = qec[dir].elixir();
   }
   amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> qec_arr{
     AMREX_D_DECL(qec[0].array(), qec[1].array(), qec[2].array())};
 
   //  Temporary FArrayBoxes
-  amrex::FArrayBox divu(bxg2, 1);
-  amrex::FArrayBox pdivu(bx, 1);
+  amrex::FArrayBox divu = scratch.fab(bxg2, 1);
+  amrex::FArrayBox pdivu = scratch.fab(bx, 1);
   amrex::Elixir divueli = divu.elixir();
   amrex::Elixir pdiveli = pdivu.elixir();
   auto const& divarr = divu.array();
@@ -385,12 +395,12 @@ pc_umdrv(
   pc_umeth_2D(
     bx, bclo, bchi, domlo, domhi, q, qaux, src_q, // bcMask,
     flx[0], flx[1], qec_arr[0], qec_arr[1], a[0], a[1], pdivuarr, vol, dx, dt,
-    ppm_type, use_flattening);
+    ppm_type, use_flattening, riemann_solver);
 #elif AMREX_SPACEDIM == 3
   pc_umeth_3D(
     bx, bclo, bchi, domlo, domhi, q, qaux, src_q, // bcMask,
     flx[0], flx[1], flx[2], qec_arr[0], qec_arr[1], qec_arr[2], a[0], a[1],
-    a[2], pdivuarr, vol, dx, dt, ppm_type, use_flattening);
+    a[2], pdivuarr, vol, dx, dt, ppm_type, use_flattening, riemann_solver);
 #endif
   BL_PROFILE_VAR_STOP(umeth);
   for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
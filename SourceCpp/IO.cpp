@@ -90,6 +90,9 @@ PeleC::restart(amrex::Amr& papa, istream& is, bool bReadSpecial)
   buildMetrics();
 
 #ifdef PELEC_USE_EB
+  if (eb_stencil_cache != 0) {
+    eb_cache_dir = papa.theRestartFile();
+  }
   init_eb(geom, grids, dmap);
 #endif
 
@@ -244,6 +247,13 @@ PeleC::checkPoint(
 {
   amrex::AmrLevel::checkPoint(dir, os, how, dump_old);
 
+#ifdef PELEC_USE_EB
+  // The level directory was created by AmrLevel::checkPoint
+  if (eb_stencil_cache != 0 && eb_in_domain) {
+    write_eb_stencil_cache(dir);
+  }
+#endif
+
 #ifdef AMREX_PARTICLES
   bool is_checkpoint = true;
 
@@ -1,12 +1,153 @@
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include <AMReX_NFiles.H>
+#include <AMReX_VisMF.H>
+
 #include "EB.H"
 #include "prob.H"
 #include "Utilities.H"
 
-#ifdef AMREX_USE_GPU
-#include <thrust/unique.h>
-#include <thrust/sort.h>
-#include <thrust/execution_policy.h>
-#endif
+namespace {
+// Layout version of the EB stencil files written with checkpoints
+constexpr int eb_stencil_cache_version = 3;
+
+// Weighted sums over all the components of a fab, relative to its lower
+// corner; records are also checked against their box, so this only has to
+// tell apart geometries cutting the same box differently
+amrex::GpuArray<amrex::Real, 2>
+pc_fab_checksum(const amrex::FArrayBox& fab)
+{
+  const amrex::Box bx = fab.box();
+  auto const& v = fab.const_array();
+  const auto lo = amrex::lbound(bx);
+  amrex::ReduceOps<amrex::ReduceOpSum, amrex::ReduceOpSum> reduce_op;
+  amrex::ReduceData<amrex::Real, amrex::Real> reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+  reduce_op.eval(
+    bx, fab.nComp(), reduce_data,
+    [=] AMREX_GPU_DEVICE(int i, int j, int k, int n) noexcept -> ReduceTuple {
+      const int lin = (i - lo.x) + 3 * (j - lo.y) + 7 * (k - lo.z) + 11 * n;
+      const amrex::Real w = 1 + lin % 97;
+      return {v(i, j, k, n), w * v(i, j, k, n)};
+    });
+  ReduceTuple hv = reduce_data.value();
+  return {amrex::get<0>(hv), amrex::get<1>(hv)};
+}
+
+// Fingerprint of the EB geometry of a grown fab (volume fractions, boundary
+// centroids, area fractions and face centroids), used to make sure the
+// cached stencils belong to the geometry that was just built
+amrex::Vector<amrex::Real>
+pc_eb_fingerprint(
+  const amrex::EBFArrayBoxFactory& ebfactory,
+  const amrex::MultiFab& vf,
+  const amrex::MFIter& mfi)
+{
+  amrex::Vector<amrex::Real> fp;
+  auto add = [&fp](const amrex::FArrayBox* fab) {
+    const auto chk =
+      fab != nullptr ? pc_fab_checksum(*fab)
+                     : amrex::GpuArray<amrex::Real, 2>{0.0, 0.0};
+    fp.push_back(chk[0]);
+    fp.push_back(chk[1]);
+  };
+  add(&vf[mfi]);
+  const amrex::MultiCutFab& bndrycent = ebfactory.getBndryCent();
+  add(bndrycent.ok(mfi) ? &bndrycent[mfi] : nullptr);
+  const auto areafrac = ebfactory.getAreaFrac();
+  const auto facecent = ebfactory.getFaceCent();
+  for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+    add(areafrac[dir]->ok(mfi) ? &(*areafrac[dir])[mfi] : nullptr);
+    add(facecent[dir]->ok(mfi) ? &(*facecent[dir])[mfi] : nullptr);
+  }
+  return fp;
+}
+
+template <typename T>
+void
+write_stencil_vector(std::ostream& os, const amrex::Gpu::DeviceVector<T>& dv)
+{
+  static_assert(
+    std::is_trivially_copyable<T>::value, "stencil is not trivially copyable");
+  const long n = dv.size();
+  amrex::Vector<T> hv(n);
+  amrex::Gpu::copy(amrex::Gpu::deviceToHost, dv.begin(), dv.end(), hv.begin());
+  os.write(reinterpret_cast<const char*>(&n), sizeof(n));
+  os.write(reinterpret_cast<const char*>(hv.data()), n * sizeof(T));
+}
+
+template <typename T>
+bool
+read_stencil_vector(std::istream& is, amrex::Gpu::DeviceVector<T>& dv)
+{
+  long n = -1;
+  is.read(reinterpret_cast<char*>(&n), sizeof(n));
+  if (!is || n < 0) {
+    return false;
+  }
+  amrex::Vector<T> hv(n);
+  is.read(reinterpret_cast<char*>(hv.data()), n * sizeof(T));
+  if (!is) {
+    return false;
+  }
+  dv.resize(n);
+  amrex::Gpu::copy(amrex::Gpu::hostToDevice, hv.begin(), hv.end(), dv.begin());
+  return true;
+}
+
+// Everything the sparse EB structures depend on besides the cut cells
+amrex::Vector<long>
+eb_stencil_cache_key(
+  const amrex::Geometry& geom,
+  const amrex::BoxArray& grids,
+  const int nghost,
+  const int bgs,
+  const amrex::Real small_vfrac)
+{
+  amrex::Vector<long> key = {
+    eb_stencil_cache_version,
+    static_cast<long>(sizeof(amrex::Real)),
+    static_cast<long>(sizeof(EBBndryGeom)),
+    static_cast<long>(sizeof(EBBndrySten)),
+    static_cast<long>(sizeof(EBRedistSten)),
+    static_cast<long>(sizeof(FaceSten)),
+    nghost,
+    bgs,
+    static_cast<long>(std::hash<amrex::Real>{}(small_vfrac)),
+    static_cast<long>(grids.size())};
+  // The boxes themselves, so that a regrid keeping their number does not
+  // match
+  std::size_t hash = 0;
+  for (int n = 0; n < grids.size(); ++n) {
+    const amrex::Box& b = grids[n];
+    for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+      for (const int v : {b.smallEnd(dir), b.bigEnd(dir)}) {
+        hash ^= std::hash<int>{}(v) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+      }
+    }
+  }
+  key.push_back(static_cast<long>(hash));
+  for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+    key.push_back(geom.Domain().smallEnd(dir));
+    key.push_back(geom.Domain().bigEnd(dir));
+    key.push_back(
+      static_cast<long>(std::hash<amrex::Real>{}(geom.ProbLo(dir))));
+    key.push_back(
+      static_cast<long>(std::hash<amrex::Real>{}(geom.ProbHi(dir))));
+  }
+  return key;
+}
+
+// The header EBStencils_H holds the key and the location of the record of
+// each box in the EBStencils_D_XXXXX data files
+std::string
+eb_stencil_cache_prefix(const std::string& dir, const int level)
+{
+  return dir + "/" + amrex::Concatenate("Level_", level, 1) + "/EBStencils";
+}
+} // namespace
 
 inline bool
 PeleC::ebInitialized()
@@ -46,9 +187,21 @@ PeleC::initialize_eb2_structs()
   BL_PROFILE("PeleC::initialize_eb2_structs()");
   amrex::Print() << "Initializing EB2 structs" << std::endl;
 
-  // NOTE: THIS NEEDS TO BE REPLACED WITH A FLAGFAB
+  // Wall time of each setup stage, reported when verbose
+  amrex::Vector<std::string> stage_names;
+  amrex::Vector<amrex::Real> stage_times;
+  amrex::Real stage_start = amrex::ParallelDescriptor::second();
+  auto end_stage = [&](const std::string& name) {
+    if (verbose) {
+      amrex::Gpu::streamSynchronize();
+      const amrex::Real now = amrex::ParallelDescriptor::second();
+      stage_names.push_back(name);
+      stage_times.push_back(now - stage_start);
+      stage_start = now;
+    }
+  };
 
-  //  1->regular, 0->irregular, -1->covered, 2->outside
+  //  1->regular, 0->irregular, -1->covered
   ebmask.define(grids, dmap, 1, 0);
 
   static_assert(
@@ -74,8 +227,12 @@ PeleC::initialize_eb2_structs()
   // First pass over fabs to fill sparse per cut-cell ebg structures
   sv_eb_bndry_geom.resize(vfrac.local_size());
   sv_eb_bndry_grad_stencil.resize(vfrac.local_size());
+  sv_eb_redist_stencil.resize(vfrac.local_size());
   sv_eb_flux.resize(vfrac.local_size());
   sv_eb_bcval.resize(vfrac.local_size());
+  for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
+    flux_interp_stencil[dir].resize(vfrac.local_size());
+  }
 
   auto const& flags = ebfactory.getMultiEBCellFlagFab();
 
@@ -84,7 +241,29 @@ PeleC::initialize_eb2_structs()
 
   int bgs = -1;
   pp.get("boundary_grad_stencil_type", bgs);
+  if (bgs == 1 || bgs == 2) {
+    amrex::Print() << "This gradient stencil type WIP and not functional!"
+                   << bgs << std::endl;
+    amrex::Abort();
+    // pc_fill_bndry_grad_stencil_amrex / pc_fill_bndry_grad_stencil_ls
+  } else if (bgs != 0) {
+    amrex::Print() << "Unknown or unspecified boundary gradient stencil type:"
+                   << bgs << std::endl;
+    amrex::Abort();
+  }
+  end_stage("setup");
+
+  // On restart, the stencils saved with the checkpoint replace the
+  // compaction and all the stencil construction below
+  const bool from_cache =
+    !eb_cache_dir.empty() && read_eb_stencil_cache(eb_cache_dir);
+  eb_cache_dir.clear();
+  if (eb_stencil_cache != 0) {
+    end_stage("stencil cache read");
+  }
 
+  // Mask, and compaction of the cut cells of each grown fab into its
+  // sv_eb_bndry_geom, in lexicographic order
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -101,122 +280,105 @@ PeleC::initialize_eb2_structs()
     } else if (typ == amrex::FabType::covered) {
       mfab.setVal<amrex::RunOn::Device>(-1);
     } else if (typ == amrex::FabType::singlevalued) {
-      int Ncut = 0;
-      for (amrex::BoxIterator bit(tbox); bit.ok(); ++bit) {
-        const amrex::EBCellFlag& flag = flagfab(bit(), 0);
-
-        if (!(flag.isRegular() || flag.isCovered())) {
-          Ncut++;
-        }
-      }
+      auto const& flag_arr = flagfab.const_array();
+      auto const& mask_arr = mfab.array();
+      amrex::ParallelFor(
+        mfab.box(), [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          const amrex::EBCellFlag& flag = flag_arr(i, j, k);
+          mask_arr(i, j, k) =
+            flag.isRegular() ? 1 : (flag.isCovered() ? -1 : 0);
+        });
 
-      sv_eb_bndry_geom[iLocal].resize(Ncut);
-      int ivec = 0;
-      for (amrex::BoxIterator bit(tbox); bit.ok(); ++bit) {
-        const amrex::EBCellFlag& flag = flagfab(bit(), 0);
-
-        if (!(flag.isRegular() || flag.isCovered())) {
-          EBBndryGeom* d_sv_eb_bndry_geom = sv_eb_bndry_geom[iLocal].data();
-          amrex::IntVect captured_bit = bit();
-          // Serial loop on the GPU
-          amrex::ParallelFor(1, [=] AMREX_GPU_DEVICE(int dummy) {
-            d_sv_eb_bndry_geom[ivec].iv = captured_bit;
-          });
-          ivec++;
-
-          if (mfab.box().contains(bit()))
-            mfab(bit()) = 0;
-        } else {
-          if (flag.isRegular()) {
-            if (mfab.box().contains(bit()))
-              mfab(bit()) = 1;
-          } else if (flag.isCovered()) {
-            if (mfab.box().contains(bit()))
-              mfab(bit()) = -1;
-          } else {
-            if (mfab.box().contains(bit()))
-              mfab(bit()) = 2;
-          }
-        }
+      if (from_cache) {
+        continue;
       }
+      pc_compact(
+        tbox, sv_eb_bndry_geom[iLocal],
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          const amrex::EBCellFlag& flag = flag_arr(i, j, k);
+          return !(flag.isRegular() || flag.isCovered());
+        },
+        [=] AMREX_GPU_DEVICE(EBBndryGeom & ebg, int i, int j, int k) noexcept {
+          ebg.iv = amrex::IntVect(AMREX_D_DECL(i, j, k));
+        });
+    } else {
+      amrex::Print() << "unknown (or multivalued) fab type" << std::endl;
+      amrex::Abort();
+    }
+  }
+  end_stage("cut cell compaction");
 
-      int Nebg = sv_eb_bndry_geom[iLocal].size();
-
-      // Now fill the sv_eb_bndry_geom
-      auto const& vfrac_arr = vfrac.array(mfi);
-      auto const& bndrycent_arr = bndrycent->array(mfi);
-      auto const& eb2areafrac_arr_0 = eb2areafrac[0]->array(mfi);
-      auto const& eb2areafrac_arr_1 = eb2areafrac[1]->array(mfi);
-      auto const& eb2areafrac_arr_2 = eb2areafrac[2]->array(mfi);
-      pc_fill_sv_ebg(
-        tbox, Ncut, vfrac_arr, bndrycent_arr,
-        AMREX_D_DECL(eb2areafrac_arr_0, eb2areafrac_arr_1, eb2areafrac_arr_2),
-        sv_eb_bndry_geom[iLocal].data());
-
-      sv_eb_bndry_grad_stencil[iLocal].resize(Ncut);
-
-      // Fill in boundary gradient for cut cells in this grown tile
-      const amrex::Real dx = geom.CellSize()[0];
-#ifdef AMREX_USE_GPU
-      const int sv_eb_bndry_geom_size = sv_eb_bndry_geom[iLocal].size();
-      thrust::sort(
-        thrust::device, sv_eb_bndry_geom[iLocal].data(),
-        sv_eb_bndry_geom[iLocal].data() + sv_eb_bndry_geom_size,
-        EBBndryGeomCmp());
-#else
-      sort<amrex::Gpu::DeviceVector<EBBndryGeom>>(sv_eb_bndry_geom[iLocal]);
+  // Geometry and boundary gradient stencils of the cut cells
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
+  for (amrex::MFIter mfi(vfrac, false); mfi.isValid(); ++mfi) {
+    const amrex::Box tbox = mfi.growntilebox();
+    if (
+      from_cache ||
+      flags[mfi].getType(tbox) != amrex::FabType::singlevalued) {
+      continue;
+    }
+    int iLocal = mfi.LocalIndex();
+    const int Ncut = sv_eb_bndry_geom[iLocal].size();
+
+    auto const& vfrac_arr = vfrac.array(mfi);
+    auto const& bndrycent_arr = bndrycent->array(mfi);
+    auto const& eb2areafrac_arr_0 = eb2areafrac[0]->array(mfi);
+    auto const& eb2areafrac_arr_1 = eb2areafrac[1]->array(mfi);
+    auto const& eb2areafrac_arr_2 = eb2areafrac[2]->array(mfi);
+    pc_fill_sv_ebg(
+      tbox, Ncut, vfrac_arr, bndrycent_arr,
+      AMREX_D_DECL(eb2areafrac_arr_0, eb2areafrac_arr_1, eb2areafrac_arr_2),
+      sv_eb_bndry_geom[iLocal].data());
+
+    // Fill in boundary gradient for cut cells in this grown tile
+    const amrex::Real dx = geom.CellSize()[0];
+    sv_eb_bndry_grad_stencil[iLocal].resize(Ncut);
+    pc_fill_bndry_grad_stencil(
+      tbox, dx, Ncut, sv_eb_bndry_geom[iLocal].data(), Ncut,
+      sv_eb_bndry_grad_stencil[iLocal].data());
+  }
+  end_stage("boundary geometry and gradient stencils");
 
-      if (bgs == 0) {
-        pc_fill_bndry_grad_stencil(
-          tbox, dx, Ncut, sv_eb_bndry_geom[iLocal].data(), Ncut,
-          sv_eb_bndry_grad_stencil[iLocal].data());
-      } else if (bgs == 1) {
-        amrex::Print() << "This gradient stencil type WIP and not functional!"
-                       << bgs << std::endl;
-        amrex::Abort();
-        // pc_fill_bndry_grad_stencil_amrex(AMREX_TO_FORTRAN_BOX(tbox),
-        //                                 sv_eb_bndry_geom[iLocal].data(),
-        //                                 &Ncut,
-        //                                 sv_eb_bndry_grad_stencil[iLocal].data(),
-        //                                 &Ncut, &dx);
-      } else if (bgs == 2) {
-        amrex::Print() << "This gradient stencil type WIP and not functional!"
-                       << bgs << std::endl;
-        amrex::Abort();
-        // pc_fill_bndry_grad_stencil_ls(AMREX_TO_FORTRAN_BOX(tbox),
-        //                              sv_eb_bndry_geom[iLocal].data(), &Ncut,
-        //                              sv_eb_bndry_grad_stencil[iLocal].data(),
-        //                              &Ncut, &dx);
-      } else {
-        amrex::Print()
-          << "Unknown or unspecified boundary gradient stencil type:" << bgs
-          << std::endl;
-        amrex::Abort();
-      }
-
-      sv_eb_flux[iLocal].define(sv_eb_bndry_grad_stencil[iLocal], NVAR);
-      sv_eb_bcval[iLocal].define(sv_eb_bndry_grad_stencil[iLocal], QVAR);
+  // Redistribution weights and sparse boundary data
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(vfrac, false); mfi.isValid(); ++mfi) {
+    const amrex::Box tbox = mfi.growntilebox();
+    const amrex::EBCellFlagFab& flagfab = flags[mfi];
+    if (flagfab.getType(tbox) != amrex::FabType::singlevalued) {
+      continue;
+    }
+    int iLocal = mfi.LocalIndex();
+    const int Ncut = sv_eb_bndry_geom[iLocal].size();
+
+    // Redistribution weights, computed once per grid layout
+    if (!from_cache) {
+      sv_eb_redist_stencil[iLocal].resize(Ncut);
+      pc_fill_redist_stencil(
+        tbox, Ncut, sv_eb_bndry_geom[iLocal].data(), flagfab.const_array(),
+        vfrac.const_array(mfi), eb_small_vfrac,
+        sv_eb_redist_stencil[iLocal].data());
+    }
 
-      if (eb_isothermal && (diffuse_temp != 0 || diffuse_enth != 0)) {
-        sv_eb_bcval[iLocal].setVal(eb_boundary_T, QTEMP);
-      }
-      if (eb_noslip && diffuse_vel == 1) {
-        sv_eb_bcval[iLocal].setVal(0, QU, AMREX_SPACEDIM);
-      }
+    sv_eb_flux[iLocal].define(sv_eb_bndry_grad_stencil[iLocal], NVAR);
+    sv_eb_bcval[iLocal].define(sv_eb_bndry_grad_stencil[iLocal], QVAR);
 
-    } else {
-      amrex::Print() << "unknown (or multivalued) fab type" << std::endl;
-      amrex::Abort();
+    if (eb_isothermal && (diffuse_temp != 0 || diffuse_enth != 0)) {
+      sv_eb_bcval[iLocal].setVal(eb_boundary_T, QTEMP);
+    }
+    if (eb_noslip && diffuse_vel == 1) {
+      sv_eb_bcval[iLocal].setVal(0, QU, AMREX_SPACEDIM);
     }
   }
+  end_stage("redistribution stencils");
 
   // Second pass over dirs and fabs to fill flux interpolation stencils
   amrex::Box fbox[AMREX_SPACEDIM];
 
-  for (int dir = 0; dir < AMREX_SPACEDIM; ++dir) {
-    flux_interp_stencil[dir].resize(vfrac.local_size());
-
+  for (int dir = 0; dir < AMREX_SPACEDIM && !from_cache; ++dir) {
     fbox[dir] = amrex::bdryLo(
       amrex::Box(
         amrex::IntVect(D_DECL(0, 0, 0)), amrex::IntVect(D_DECL(0, 0, 0))),
@@ -238,86 +400,36 @@ PeleC::initialize_eb2_structs()
 
       if (typ == amrex::FabType::regular || typ == amrex::FabType::covered) {
       } else if (typ == amrex::FabType::singlevalued) {
-        const amrex::Box ebox = amrex::Box(tbox).surroundingNodes(dir);
         const auto afrac_arr = (*eb2areafrac[dir])[mfi].array();
         const auto facecent_arr = (*facecent[dir])[mfi].array();
 
-        // This used to be an std::set for cut_faces (it ensured
-        // sorting and uniqueness)
-        EBBndryGeom* d_sv_eb_bndry_geom = sv_eb_bndry_geom[iLocal].data();
-        amrex::Gpu::LaunchSafeGuard lsg(true);
-        amrex::Gpu::DeviceScalar<int> ds(0);
-        int* dp = ds.dataPtr();
-        amrex::VecReduce(
-          sv_eb_bndry_geom[iLocal].size(), 0,
-          [=] AMREX_GPU_DEVICE(int i, int* r) noexcept {
-            const amrex::IntVect& iv = d_sv_eb_bndry_geom[i].iv;
+        // Faces with an area fraction below one on either side of a cut cell
+        // of sv_eb_bndry_geom, gathered without duplicates and in
+        // lexicographic order
+        const amrex::Box cbox = mfi.growntilebox();
+        const amrex::Box ebox = amrex::Box(cbox).surroundingNodes(dir);
+        auto const& flag_arr = flagfab.const_array();
+        const amrex::IntVect shift = amrex::BASISV(dir);
+        const int Nsten = pc_compact(
+          ebox, flux_interp_stencil[dir][iLocal],
+          [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            const amrex::IntVect iv(AMREX_D_DECL(i, j, k));
+            bool next_to_cut = false;
             for (int iside = 0; iside <= 1; iside++) {
-              const amrex::IntVect iv_face = iv + iside * amrex::BASISV(dir);
-              if (afrac_arr(iv_face) < 1.0) {
-                *r += 1;
+              const amrex::IntVect ivc = iv - iside * shift;
+              if (cbox.contains(ivc)) {
+                const amrex::EBCellFlag& flag = flag_arr(ivc);
+                next_to_cut =
+                  next_to_cut || !(flag.isRegular() || flag.isCovered());
               }
             }
+            return next_to_cut && afrac_arr(iv) < 1.0;
           },
-          [=] AMREX_GPU_DEVICE(int const& r) noexcept {
-            amrex::Gpu::deviceReduceSum(dp, r);
+          [=] AMREX_GPU_DEVICE(FaceSten & sten, int i, int j, int k) noexcept {
+            sten.iv = amrex::IntVect(AMREX_D_DECL(i, j, k));
           });
-        const int Nall_cut_faces = ds.dataValue();
-
-        amrex::Gpu::DeviceVector<amrex::IntVect> v_all_cut_faces(
-          Nall_cut_faces);
-        amrex::IntVect* all_cut_faces = v_all_cut_faces.data();
-
-        const int sv_eb_bndry_geom_size = sv_eb_bndry_geom[iLocal].size();
-        // Serial loop on the GPU
-        amrex::ParallelFor(1, [=] AMREX_GPU_DEVICE(int dummy) {
-          int cnt = 0;
-          for (int i = 0; i < sv_eb_bndry_geom_size; i++) {
-            const amrex::IntVect& iv = d_sv_eb_bndry_geom[i].iv;
-            for (int iside = 0; iside <= 1; iside++) {
-              const amrex::IntVect iv_face = iv + iside * amrex::BASISV(dir);
-              if (afrac_arr(iv_face) < 1.0) {
-                all_cut_faces[cnt] = iv_face;
-                cnt++;
-              }
-            }
-          }
-        });
-
-#ifdef AMREX_USE_GPU
-        const int v_all_cut_faces_size = v_all_cut_faces.size();
-        thrust::sort(
-          thrust::device, v_all_cut_faces.data(),
-          v_all_cut_faces.data() + v_all_cut_faces_size);
-        amrex::IntVect* unique_result_end = thrust::unique(
-          v_all_cut_faces.data(), v_all_cut_faces.data() + v_all_cut_faces_size,
-          thrust::equal_to<amrex::IntVect>());
-        const int count_result =
-          thrust::count(v_all_cut_faces.data(), unique_result_end, 1);
-        amrex::Gpu::DeviceVector<amrex::IntVect> v_cut_faces(count_result);
-        amrex::IntVect* d_all_cut_faces = v_all_cut_faces.data();
-        amrex::IntVect* d_cut_faces = v_cut_faces.data();
-        amrex::ParallelFor(
-          v_cut_faces.size(), [=] AMREX_GPU_DEVICE(int i) noexcept {
-            d_cut_faces[i] = d_all_cut_faces[i];
-          });
-#else
-        sort<amrex::Gpu::DeviceVector<amrex::IntVect>>(v_all_cut_faces);
-        amrex::Gpu::DeviceVector<amrex::IntVect> v_cut_faces =
-          unique<amrex::Gpu::DeviceVector<amrex::IntVect>>(v_all_cut_faces);
-#endif
 
-        const int Nsten = v_cut_faces.size();
         if (Nsten > 0) {
-          flux_interp_stencil[dir][iLocal].resize(Nsten);
-
-          amrex::IntVect* cut_faces = v_cut_faces.data();
-          auto* d_flux_interp_stencil = flux_interp_stencil[dir][iLocal].data();
-          amrex::ParallelFor(
-            v_cut_faces.size(), [=] AMREX_GPU_DEVICE(int i) noexcept {
-              d_flux_interp_stencil[i].iv = cut_faces[i];
-            });
-
           pc_fill_flux_interp_stencil(
             tbox, fbox[dir], Nsten, facecent_arr, afrac_arr,
             flux_interp_stencil[dir][iLocal].data());
@@ -327,6 +439,200 @@ PeleC::initialize_eb2_structs()
       }
     }
   }
+  end_stage("flux interpolation stencils");
+
+  if (verbose) {
+    const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+    amrex::ParallelDescriptor::ReduceRealMax(
+      stage_times.data(), static_cast<int>(stage_times.size()), IOProc);
+    int ncached = from_cache ? 1 : 0;
+    amrex::ParallelDescriptor::ReduceIntSum(ncached, IOProc);
+    amrex::Print() << "PeleC::initialize_eb2_structs() at level " << level
+                   << " :" << std::endl;
+    if (eb_stencil_cache != 0) {
+      amrex::Print() << "  stencils read from checkpoint on " << ncached
+                     << " of " << amrex::ParallelDescriptor::NProcs()
+                     << " ranks" << std::endl;
+    }
+    for (int n = 0; n < stage_names.size(); ++n) {
+      amrex::Print() << "  " << stage_names[n]
+                     << " : time = " << stage_times[n] << std::endl;
+    }
+  }
+}
+
+/**
+ * Read the sparse EB structures of this level saved by
+ * write_eb_stencil_cache in checkpoint dir. Returns false, leaving them
+ * empty, if the files do not hold every local fab or if the geometry,
+ * grids or stencil options have changed since they were written.
+ */
+bool
+PeleC::read_eb_stencil_cache(const std::string& dir)
+{
+  BL_PROFILE("PeleC::read_eb_stencil_cache()");
+
+  const std::string prefix = eb_stencil_cache_prefix(dir, level);
+  amrex::Vector<char> header;
+  amrex::ParallelDescriptor::ReadAndBcastFile(prefix + "_H", header, false);
+  if (header.empty()) {
+    return false;
+  }
+  std::istringstream his(header.dataPtr());
+
+  amrex::ParmParse pp("ebd");
+  int bgs = -1;
+  pp.get("boundary_grad_stencil_type", bgs);
+  const amrex::Vector<long> key = eb_stencil_cache_key(
+    geom, grids, vfrac.nGrow(), bgs, eb_small_vfrac);
+  amrex::Vector<long> file_key(key.size());
+  for (auto& v : file_key) {
+    his >> v;
+  }
+  long nbox = -1;
+  his >> nbox;
+  if (!his || file_key != key || nbox != grids.size()) {
+    return false;
+  }
+
+  // File number, offset and size of the record of each box
+  amrex::Vector<long> records(3 * nbox);
+  for (auto& v : records) {
+    his >> v;
+  }
+
+  const auto& ebfactory =
+    dynamic_cast<amrex::EBFArrayBoxFactory const&>(Factory());
+  std::map<long, std::ifstream> files;
+  bool ok = static_cast<bool>(his);
+  for (amrex::MFIter mfi(vfrac, false); mfi.isValid() && ok; ++mfi) {
+    const int iLocal = mfi.LocalIndex();
+    const long* rec = &records[3 * mfi.index()];
+    if (files.count(rec[0]) == 0) {
+      files[rec[0]].open(
+        amrex::NFilesIter::FileName(static_cast<int>(rec[0]), prefix + "_D_"),
+        std::ios::binary);
+    }
+    std::ifstream& ifs = files[rec[0]];
+    ifs.seekg(rec[1]);
+
+    // The stencils hold absolute cell indices: the record must be for
+    // this very box
+    amrex::Box bx;
+    ifs.read(reinterpret_cast<char*>(&bx), sizeof(bx));
+    ok = ifs && bx == grids[mfi.index()];
+
+    const auto fp = pc_eb_fingerprint(ebfactory, vfrac, mfi);
+    long nfp = -1;
+    ifs.read(reinterpret_cast<char*>(&nfp), sizeof(nfp));
+    ok = ok && ifs && nfp == static_cast<long>(fp.size());
+    amrex::Vector<amrex::Real> file_fp(ok ? nfp : 0);
+    ifs.read(
+      reinterpret_cast<char*>(file_fp.data()),
+      file_fp.size() * sizeof(amrex::Real));
+    for (int n = 0; n < file_fp.size() && ok; ++n) {
+      const amrex::Real tol = 1.0e-12 * (1.0 + std::abs(fp[n]));
+      ok = ifs && std::abs(file_fp[n] - fp[n]) <= tol;
+    }
+
+    ok = ok && read_stencil_vector(ifs, sv_eb_bndry_geom[iLocal]) &&
+         read_stencil_vector(ifs, sv_eb_bndry_grad_stencil[iLocal]) &&
+         read_stencil_vector(ifs, sv_eb_redist_stencil[iLocal]);
+    for (int d = 0; d < AMREX_SPACEDIM && ok; ++d) {
+      ok = read_stencil_vector(ifs, flux_interp_stencil[d][iLocal]);
+    }
+    ok = ok && (ifs.tellg() - std::streampos(rec[1]) == rec[2]);
+  }
+
+  if (!ok) {
+    for (int i = 0; i < vfrac.local_size(); ++i) {
+      sv_eb_bndry_geom[i].clear();
+      sv_eb_bndry_grad_stencil[i].clear();
+      sv_eb_redist_stencil[i].clear();
+      for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+        flux_interp_stencil[d][i].clear();
+      }
+    }
+  }
+  return ok;
+}
+
+/**
+ * Save the sparse EB structures of this level in checkpoint dir, so that a
+ * restart on the same grids can skip their construction. The records are
+ * written through NFilesIter into as many files as the checkpoint fabs.
+ */
+void
+PeleC::write_eb_stencil_cache(const std::string& dir) const
+{
+  BL_PROFILE("PeleC::write_eb_stencil_cache()");
+
+  const auto& ebfactory =
+    dynamic_cast<amrex::EBFArrayBoxFactory const&>(Factory());
+  amrex::Vector<std::string> recs;
+  for (amrex::MFIter mfi(vfrac, false); mfi.isValid(); ++mfi) {
+    const int iLocal = mfi.LocalIndex();
+    std::ostringstream rec;
+    const amrex::Box bx = mfi.validbox();
+    rec.write(reinterpret_cast<const char*>(&bx), sizeof(bx));
+    const auto fp = pc_eb_fingerprint(ebfactory, vfrac, mfi);
+    const long nfp = fp.size();
+    rec.write(reinterpret_cast<const char*>(&nfp), sizeof(nfp));
+    rec.write(
+      reinterpret_cast<const char*>(fp.data()), nfp * sizeof(amrex::Real));
+    write_stencil_vector(rec, sv_eb_bndry_geom[iLocal]);
+    write_stencil_vector(rec, sv_eb_bndry_grad_stencil[iLocal]);
+    write_stencil_vector(rec, sv_eb_redist_stencil[iLocal]);
+    for (int d = 0; d < AMREX_SPACEDIM; ++d) {
+      write_stencil_vector(rec, flux_interp_stencil[d][iLocal]);
+    }
+    recs.push_back(rec.str());
+  }
+
+  // File number, offset and size of the record of each box
+  const std::string prefix = eb_stencil_cache_prefix(dir, level);
+  const int nfiles =
+    amrex::NFilesIter::ActualNFiles(amrex::VisMF::GetNOutFiles());
+  amrex::Vector<long> records(3 * grids.size(), 0);
+  for (amrex::NFilesIter nfi(nfiles, prefix + "_D_", false, true);
+       nfi.ReadyToWrite(); ++nfi) {
+    std::fstream& ofs = nfi.Stream();
+    for (amrex::MFIter mfi(vfrac, false); mfi.isValid(); ++mfi) {
+      const std::string& buf = recs[mfi.LocalIndex()];
+      long* rec = &records[3 * mfi.index()];
+      rec[0] = nfi.FileNumber();
+      rec[1] = static_cast<long>(ofs.tellp());
+      rec[2] = static_cast<long>(buf.size());
+      ofs.write(buf.data(), buf.size());
+    }
+    if (!ofs.good()) {
+      amrex::FileOpenFailed(nfi.FileName());
+    }
+  }
+
+  const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+  amrex::ParallelDescriptor::ReduceLongSum(
+    records.data(), static_cast<int>(records.size()), IOProc);
+  if (amrex::ParallelDescriptor::IOProcessor()) {
+    amrex::ParmParse pp("ebd");
+    int bgs = -1;
+    pp.get("boundary_grad_stencil_type", bgs);
+    const amrex::Vector<long> key = eb_stencil_cache_key(
+      geom, grids, vfrac.nGrow(), bgs, eb_small_vfrac);
+
+    std::ofstream hos(prefix + "_H");
+    for (const long v : key) {
+      hos << v << " ";
+    }
+    hos << "\n" << grids.size() << "\n";
+    for (int n = 0; n < grids.size(); ++n) {
+      hos << records[3 * n] << " " << records[3 * n + 1] << " "
+          << records[3 * n + 2] << "\n";
+    }
+    if (!hos.good()) {
+      amrex::FileOpenFailed(prefix + "_H");
+    }
+  }
 }
 
 void
@@ -392,12 +392,18 @@ PeleC::getDynamicSmagorinskyLESTerm(
 
   */
   // clang-format on
-  Filter test_filter = Filter(les_test_filter_type, les_test_filter_fgr);
-  Filter coeff_filter = Filter(box, 6);
-
   const int nGrowD = 1;
-  const int nGrowC = coeff_filter.get_filter_ngrow();
-  const int nGrowT = test_filter.get_filter_ngrow();
+  const int nGrowC = les_coeff_filter.get_filter_ngrow();
+  const int nGrowT = les_test_filter.get_filter_ngrow();
+
+  // The dynamic coefficients are only recomputed every
+  // les_coeff_update_interval evaluations. In between, the lagged LES_Coeffs
+  // are used and only the derived quantities needed by the fluxes are
+  // evaluated, which needs nGrowD + 1 grow cells instead of the full depth.
+  const bool update_coeffs = (les_coeff_evals % les_coeff_update_interval) == 0;
+  les_coeff_evals++;
+  const int nGrowS = nGrowD + nGrowC + nGrowT + 1;
+  const int nGrowFill = update_coeffs ? nGrowS : nGrowD + 1;
 
   const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
   amrex::Real dx1 = dx[0];
@@ -408,12 +414,16 @@ PeleC::getDynamicSmagorinskyLESTerm(
     D_DECL(dx1, dx1, dx1)};
   const amrex::Real* dxDp = &(dxD[0]);
 
-  // 1. Get state variable data
-  amrex::MultiFab S(grids, dmap, NVAR, nGrowD + nGrowC + nGrowT + 1);
-  FillPatch(
-    *this, S, nGrowD + nGrowC + nGrowT + 1, time, State_Type, 0,
-    NVAR); // FIXME: time+dt?
-  LES_Coeffs.setVal(0.0);
+  // 1. Get state variable data, in a deep-halo MultiFab kept for the
+  // lifetime of this level
+  if (les_state.empty()) {
+    les_state.define(grids, dmap, NVAR, nGrowS, amrex::MFInfo(), Factory());
+  }
+  amrex::MultiFab& S = les_state;
+  FillPatch(*this, S, nGrowFill, time, State_Type, 0, NVAR); // FIXME: time+dt?
+  if (update_coeffs) {
+    LES_Coeffs.setVal(0.0);
+  }
 
   // Fetch some gpu arrays
   prefetchToDevice(S);
@@ -432,8 +442,8 @@ PeleC::getDynamicSmagorinskyLESTerm(
   {
     for (amrex::MFIter mfi(S, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
       const amrex::Box vbox = mfi.tilebox();
-      const amrex::Box g0box = amrex::grow(vbox, nGrowD + nGrowC + nGrowT + 1);
-      const amrex::Box g1box = amrex::grow(vbox, nGrowC + nGrowT + 1);
+      const amrex::Box g0box = amrex::grow(vbox, nGrowFill);
+      const amrex::Box g1box = amrex::grow(vbox, nGrowFill - nGrowD);
       const amrex::Box g2box = amrex::grow(vbox, nGrowD + nGrowC + 1);
       const amrex::Box g3box = amrex::grow(vbox, nGrowC + 1);
       const amrex::Box g4box = amrex::grow(vbox, 1);
@@ -504,74 +514,77 @@ PeleC::getDynamicSmagorinskyLESTerm(
 
       // 3. Filter the state variables and the derived quantities at the
       // test filter level - still at cell centers
-      amrex::FArrayBox filtered_S, filtered_Q, filtered_Qaux, filtered_K,
-        filtered_RUT, filtered_alphaij, filtered_alpha, filtered_flux_T;
-      filtered_S.resize(g2box, NVAR);
-      filtered_Q.resize(g2box, QVAR);
-      filtered_Qaux.resize(g2box, NQAUX > 0 ? NQAUX : 1);
-      filtered_K.resize(g3box, upper_triangle_n);
-      filtered_RUT.resize(g3box, AMREX_SPACEDIM);
-      filtered_alphaij.resize(g3box, AMREX_SPACEDIM * AMREX_SPACEDIM);
-      filtered_alpha.resize(g3box, 1);
-      filtered_flux_T.resize(g3box, AMREX_SPACEDIM);
-      amrex::Elixir filtered_S_eli = filtered_S.elixir();
-      amrex::Elixir filtered_Q_eli = filtered_Q.elixir();
-      amrex::Elixir filtered_Qaux_eli = filtered_Qaux.elixir();
-      amrex::Elixir filtered_K_eli = filtered_K.elixir();
-      amrex::Elixir filtered_RUT_eli = filtered_RUT.elixir();
-      amrex::Elixir filtered_alphaij_eli = filtered_alphaij.elixir();
-      amrex::Elixir filtered_alpha_eli = filtered_alpha.elixir();
-      amrex::Elixir filtered_flux_T_eli = filtered_flux_T.elixir();
-
-      auto const& filtered_S_ar = filtered_S.array();
-      auto const& filtered_Q_ar = filtered_Q.array();
-      auto const& filtered_Qaux_ar = filtered_Qaux.array();
-
-      const amrex::FArrayBox& Sfab = S[mfi];
-      test_filter.apply_filter(g2box, Sfab, filtered_S);
-      {
-        BL_PROFILE("PeleC::ctoprim()");
-        amrex::ParallelFor(
-          g2box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            pc_ctoprim(i, j, k, filtered_S_ar, filtered_Q_ar, filtered_Qaux_ar);
-          });
-      }
-      test_filter.apply_filter(g3box, K, filtered_K);
-      test_filter.apply_filter(g3box, RUT, filtered_RUT);
-      test_filter.apply_filter(g3box, alphaij, filtered_alphaij);
-      test_filter.apply_filter(g3box, alpha, filtered_alpha);
-      test_filter.apply_filter(g3box, flux_T, filtered_flux_T);
-
-      // 4. Calculate the dynamic Smagorinsky coefficients - still at cell
-      // centers
-      int do_harmonic = 1;
-      amrex::FArrayBox coeff_cc;
-      coeff_cc.resize(g3box, nCompC);
-      amrex::Elixir coeff_cc_eli = coeff_cc.elixir();
-      auto const& coeff_cc_ar = coeff_cc.array();
-      auto const& filtered_K_ar = filtered_K.array();
-      auto const& filtered_RUT_ar = filtered_RUT.array();
-      auto const& filtered_alphaij_ar = filtered_alphaij.array();
-      auto const& filtered_alpha_ar = filtered_alpha.array();
-      auto const& filtered_flux_T_ar = filtered_flux_T.array();
-      {
-        const int les_test_filter_fgr = PeleC::les_test_filter_fgr;
-        BL_PROFILE("PeleC::pc_dynamic_smagorinsky_coeffs()");
-        amrex::ParallelFor(
-          g3box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            pc_dynamic_smagorinsky_coeffs(
-              i, j, k, filtered_Q_ar, les_test_filter_fgr, dx, filtered_K_ar,
-              filtered_RUT_ar, filtered_alphaij_ar, filtered_alpha_ar,
-              filtered_flux_T_ar, coeff_cc_ar);
-          });
-      }
+      if (update_coeffs) {
+        amrex::FArrayBox filtered_S, filtered_Q, filtered_Qaux, filtered_K,
+          filtered_RUT, filtered_alphaij, filtered_alpha, filtered_flux_T;
+        filtered_S.resize(g2box, NVAR);
+        filtered_Q.resize(g2box, QVAR);
+        filtered_Qaux.resize(g2box, NQAUX > 0 ? NQAUX : 1);
+        filtered_K.resize(g3box, upper_triangle_n);
+        filtered_RUT.resize(g3box, AMREX_SPACEDIM);
+        filtered_alphaij.resize(g3box, AMREX_SPACEDIM * AMREX_SPACEDIM);
+        filtered_alpha.resize(g3box, 1);
+        filtered_flux_T.resize(g3box, AMREX_SPACEDIM);
+        amrex::Elixir filtered_S_eli = filtered_S.elixir();
+        amrex::Elixir filtered_Q_eli = filtered_Q.elixir();
+        amrex::Elixir filtered_Qaux_eli = filtered_Qaux.elixir();
+        amrex::Elixir filtered_K_eli = filtered_K.elixir();
+        amrex::Elixir filtered_RUT_eli = filtered_RUT.elixir();
+        amrex::Elixir filtered_alphaij_eli = filtered_alphaij.elixir();
+        amrex::Elixir filtered_alpha_eli = filtered_alpha.elixir();
+        amrex::Elixir filtered_flux_T_eli = filtered_flux_T.elixir();
+
+        auto const& filtered_S_ar = filtered_S.array();
+        auto const& filtered_Q_ar = filtered_Q.array();
+        auto const& filtered_Qaux_ar = filtered_Qaux.array();
+
+        const amrex::FArrayBox& Sfab = S[mfi];
+        les_test_filter.apply_filter(g2box, Sfab, filtered_S);
+        {
+          BL_PROFILE("PeleC::ctoprim()");
+          amrex::ParallelFor(
+            g2box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+              pc_ctoprim(
+                i, j, k, filtered_S_ar, filtered_Q_ar, filtered_Qaux_ar);
+            });
+        }
+        les_test_filter.apply_filter(g3box, K, filtered_K);
+        les_test_filter.apply_filter(g3box, RUT, filtered_RUT);
+        les_test_filter.apply_filter(g3box, alphaij, filtered_alphaij);
+        les_test_filter.apply_filter(g3box, alpha, filtered_alpha);
+        les_test_filter.apply_filter(g3box, flux_T, filtered_flux_T);
+
+        // 4. Calculate the dynamic Smagorinsky coefficients - still at cell
+        // centers
+        amrex::FArrayBox coeff_cc;
+        coeff_cc.resize(g3box, nCompC);
+        amrex::Elixir coeff_cc_eli = coeff_cc.elixir();
+        auto const& coeff_cc_ar = coeff_cc.array();
+        auto const& filtered_K_ar = filtered_K.array();
+        auto const& filtered_RUT_ar = filtered_RUT.array();
+        auto const& filtered_alphaij_ar = filtered_alphaij.array();
+        auto const& filtered_alpha_ar = filtered_alpha.array();
+        auto const& filtered_flux_T_ar = filtered_flux_T.array();
+        {
+          const int les_test_filter_fgr = PeleC::les_test_filter_fgr;
+          BL_PROFILE("PeleC::pc_dynamic_smagorinsky_coeffs()");
+          amrex::ParallelFor(
+            g3box, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+              pc_dynamic_smagorinsky_coeffs(
+                i, j, k, filtered_Q_ar, les_test_filter_fgr, dx, filtered_K_ar,
+                filtered_RUT_ar, filtered_alphaij_ar, filtered_alpha_ar,
+                filtered_flux_T_ar, coeff_cc_ar);
+            });
+        }
 
-      // 5. Filter to smooth the dynamic coefficients - still at cell
-      // centers
-      auto const& LES_Coeffs_ar = LES_Coeffs[mfi].array();
-      coeff_filter.apply_filter(g4box, coeff_cc, LES_Coeffs[mfi]);
+        // 5. Filter to smooth the dynamic coefficients - still at cell
+        // centers
+        les_coeff_filter.apply_filter(g4box, coeff_cc, LES_Coeffs[mfi]);
+      }
 
       // 6. Get the SFS term
+      int do_harmonic = 1;
+      auto const& LES_Coeffs_ar = LES_Coeffs[mfi].array();
 
       // First step: move everything needed to compute fluxes to ec (faces)
       const amrex::Box eboxes[AMREX_SPACEDIM] = {AMREX_D_DECL(
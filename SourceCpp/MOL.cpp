@@ -1,24 +1,21 @@
 #include "MOL.H"
+#include "ScratchArena.H"
 
+namespace {
+// Fluxes through the faces normal to dir, with the Riemann solver, the
+// direction and the order of the reconstruction known at compile time
+template <int solver, int dir, int order>
 void
-pc_compute_hyp_mol_flux(
+hyp_mol_flux_dir(
   const amrex::Box& cbox,
   const amrex::Array4<const amrex::Real>& q,
   const amrex::Array4<const amrex::Real>& qaux,
-  const amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx,
-  const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
-    a,
-  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
-  const int plm_iorder
+  const amrex::Array4<amrex::Real>& dq,
+  const amrex::Array4<amrex::Real>& flx,
+  const amrex::Array4<const amrex::Real>& a
 #ifdef PELEC_USE_EB
   ,
-  const amrex::Real eb_small_vfrac,
-  const amrex::Array4<const amrex::Real>& vfrac,
-  const amrex::Array4<amrex::EBCellFlag const>& flags,
-  const EBBndryGeom* ebg,
-  const int Nebg,
-  amrex::Real* ebflux,
-  const int nebflux
+  const amrex::Array4<amrex::EBCellFlag const>& flags
 #endif
 )
 {
@@ -30,158 +27,238 @@ pc_compute_hyp_mol_flux(
   const int R_Y = 5;
   const int bc_test_val = 1;
 
-  for (int dir = 0; dir < AMREX_SPACEDIM; dir++) {
-    amrex::FArrayBox dq_fab(cbox, QVAR);
-    amrex::Elixir dq_fab_eli = dq_fab.elixir();
-    auto const& dq = dq_fab.array();
-    setV(cbox, QVAR, dq, 0.0);
-
-    // dimensional indexing
-    const amrex::GpuArray<const int, 3> bdim{dir == 0, dir == 1, dir == 2};
-    const amrex::GpuArray<const int, 3> q_idx{
-      bdim[0] * QU + bdim[1] * QV + bdim[2] * QW,
-      bdim[0] * QV + bdim[1] * QU + bdim[2] * QU,
-      bdim[0] * QW + bdim[1] * QW + bdim[2] * QV};
-    const amrex::GpuArray<const int, 3> f_idx{
-      bdim[0] * UMX + bdim[1] * UMY + bdim[2] * UMZ,
-      bdim[0] * UMY + bdim[1] * UMX + bdim[2] * UMX,
-      bdim[0] * UMZ + bdim[1] * UMZ + bdim[2] * UMY};
-
-    if (plm_iorder != 1) {
-      amrex::ParallelFor(
-        cbox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-          mol_slope(
-            i, j, k, bdim, q_idx, q, qaux, dq
+  // dimensional indexing
+  constexpr int bdim[3] = {dir == 0, dir == 1, dir == 2};
+  constexpr int q_idx[3] = {
+    dir == 0 ? QU : (dir == 1 ? QV : QW), dir == 0 ? QV : QU,
+    dir == 2 ? QV : QW};
+  constexpr int f_idx[3] = {
+    dir == 0 ? UMX : (dir == 1 ? UMY : UMZ), dir == 0 ? UMY : UMX,
+    dir == 2 ? UMY : UMZ};
+
+  if (order != 1) {
+    amrex::ParallelFor(
+      cbox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+        mol_slope<dir>(
+          i, j, k, q, qaux, dq
 #ifdef PELEC_USE_EB
-            ,
-            flags
+          ,
+          flags
 #endif
-          );
-        });
+        );
+      });
+  }
+  const amrex::Box tbox = amrex::grow(cbox, dir, -1);
+  const amrex::Box ebox = amrex::surroundingNodes(tbox, dir);
+  amrex::ParallelFor(ebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    const int ii = i - bdim[0];
+    const int jj = j - bdim[1];
+    const int kk = k - bdim[2];
+
+    // Slopes of the cells on either side, zero at first order
+    amrex::Real dql[QVAR] = {0.0};
+    amrex::Real dqr[QVAR] = {0.0};
+    if (order != 1) {
+      for (int n = 0; n < QVAR; n++) {
+        dql[n] = dq(ii, jj, kk, n);
+        dqr[n] = dq(i, j, k, n);
+      }
     }
-    const amrex::Box tbox = amrex::grow(cbox, dir, -1);
-    const amrex::Box ebox = amrex::surroundingNodes(tbox, dir);
-    amrex::ParallelFor(
-      ebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-        const int ii = i - bdim[0];
-        const int jj = j - bdim[1];
-        const int kk = k - bdim[2];
 
-        amrex::Real qtempl[5 + NUM_SPECIES] = {0.0};
-        qtempl[R_UN] =
-          q(ii, jj, kk, q_idx[0]) +
-          0.5 * ((dq(ii, jj, kk, 1) - dq(ii, jj, kk, 0)) / q(ii, jj, kk, QRHO));
-        qtempl[R_P] =
-          q(ii, jj, kk, QPRES) +
-          0.5 * (dq(ii, jj, kk, 0) + dq(ii, jj, kk, 1)) * qaux(ii, jj, kk, QC);
-        qtempl[R_UT1] = q(ii, jj, kk, q_idx[1]) + 0.5 * dq(ii, jj, kk, 2);
-        qtempl[R_UT2] = q(ii, jj, kk, q_idx[2]) + 0.5 * dq(ii, jj, kk, 3);
-        qtempl[R_RHO] = 0.0;
-        for (int n = 0; n < NUM_SPECIES; n++) {
-          qtempl[R_Y + n] = q(ii, jj, kk, QFS + n) * q(ii, jj, kk, QRHO) +
-                            0.5 * (dq(ii, jj, kk, 4 + n) +
-                                   q(ii, jj, kk, QFS + n) *
-                                     (dq(ii, jj, kk, 0) + dq(ii, jj, kk, 1)) /
-                                     qaux(ii, jj, kk, QC));
-          qtempl[R_RHO] += qtempl[R_Y + n];
-        }
+    amrex::Real qtempl[5 + NUM_SPECIES] = {0.0};
+    qtempl[R_UN] = q(ii, jj, kk, q_idx[0]) +
+                   0.5 * ((dql[1] - dql[0]) / q(ii, jj, kk, QRHO));
+    qtempl[R_P] =
+      q(ii, jj, kk, QPRES) + 0.5 * (dql[0] + dql[1]) * qaux(ii, jj, kk, QC);
+    qtempl[R_UT1] = q(ii, jj, kk, q_idx[1]) + 0.5 * dql[2];
+    qtempl[R_UT2] = q(ii, jj, kk, q_idx[2]) + 0.5 * dql[3];
+    qtempl[R_RHO] = 0.0;
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      qtempl[R_Y + n] = q(ii, jj, kk, QFS + n) * q(ii, jj, kk, QRHO) +
+                        0.5 * (dql[4 + n] + q(ii, jj, kk, QFS + n) *
+                                              (dql[0] + dql[1]) /
+                                              qaux(ii, jj, kk, QC));
+      qtempl[R_RHO] += qtempl[R_Y + n];
+    }
 
-        for (int n = 0; n < NUM_SPECIES; n++) {
-          qtempl[R_Y + n] = qtempl[R_Y + n] / qtempl[R_RHO];
-        }
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      qtempl[R_Y + n] = qtempl[R_Y + n] / qtempl[R_RHO];
+    }
 
-        amrex::Real qtempr[5 + NUM_SPECIES] = {0.0};
-        qtempr[R_UN] =
-          q(i, j, k, q_idx[0]) -
-          0.5 * ((dq(i, j, k, 1) - dq(i, j, k, 0)) / q(i, j, k, QRHO));
-        qtempr[R_P] = q(i, j, k, QPRES) - 0.5 *
-                                            (dq(i, j, k, 0) + dq(i, j, k, 1)) *
-                                            qaux(i, j, k, QC);
-        qtempr[R_UT1] = q(i, j, k, q_idx[1]) - 0.5 * dq(i, j, k, 2);
-        qtempr[R_UT2] = q(i, j, k, q_idx[2]) - 0.5 * dq(i, j, k, 3);
-        qtempr[R_RHO] = 0.0;
-        for (int n = 0; n < NUM_SPECIES; n++) {
-          qtempr[R_Y + n] =
-            q(i, j, k, QFS + n) * q(i, j, k, QRHO) -
-            0.5 * (dq(i, j, k, 4 + n) + q(i, j, k, QFS + n) *
-                                          (dq(i, j, k, 0) + dq(i, j, k, 1)) /
-                                          qaux(i, j, k, QC));
-          qtempr[R_RHO] += qtempr[R_Y + n];
-        }
-        for (int n = 0; n < NUM_SPECIES; n++) {
-          qtempr[R_Y + n] = qtempr[R_Y + n] / qtempr[R_RHO];
-        }
+    amrex::Real qtempr[5 + NUM_SPECIES] = {0.0};
+    qtempr[R_UN] =
+      q(i, j, k, q_idx[0]) - 0.5 * ((dqr[1] - dqr[0]) / q(i, j, k, QRHO));
+    qtempr[R_P] =
+      q(i, j, k, QPRES) - 0.5 * (dqr[0] + dqr[1]) * qaux(i, j, k, QC);
+    qtempr[R_UT1] = q(i, j, k, q_idx[1]) - 0.5 * dqr[2];
+    qtempr[R_UT2] = q(i, j, k, q_idx[2]) - 0.5 * dqr[3];
+    qtempr[R_RHO] = 0.0;
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      qtempr[R_Y + n] =
+        q(i, j, k, QFS + n) * q(i, j, k, QRHO) -
+        0.5 * (dqr[4 + n] +
+               q(i, j, k, QFS + n) * (dqr[0] + dqr[1]) / qaux(i, j, k, QC));
+      qtempr[R_RHO] += qtempr[R_Y + n];
+    }
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      qtempr[R_Y + n] = qtempr[R_Y + n] / qtempr[R_RHO];
+    }
 
-        const amrex::Real cavg =
-          0.5 * (qaux(i, j, k, QC) + qaux(ii, jj, kk, QC));
-        const amrex::Real csmall =
-          amrex::min(qaux(i, j, k, QCSML), qaux(ii, jj, kk, QCSML));
+    const amrex::Real cavg = 0.5 * (qaux(i, j, k, QC) + qaux(ii, jj, kk, QC));
+    const amrex::Real csmall =
+      amrex::min(qaux(i, j, k, QCSML), qaux(ii, jj, kk, QCSML));
 
-        amrex::Real eos_state_rho, eos_state_p, eos_state_e, eos_state_cs,
-          eos_state_gamma, eos_state_T;
+    // Thermodynamics of each interface state, evaluated once and
+    // handed to the Riemann solver
+    amrex::Real T_l, rhoe_l, gamc_l, cs_l;
+    amrex::Real spl[NUM_SPECIES];
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      spl[n] = qtempl[R_Y + n];
+    }
+    pc_face_eos(qtempl[R_RHO], qtempl[R_P], spl, T_l, rhoe_l, gamc_l, cs_l);
 
-        eos_state_rho = qtempl[R_RHO];
-        eos_state_p = qtempl[R_P];
-        amrex::Real spl[NUM_SPECIES];
-        for (int n = 0; n < NUM_SPECIES; n++) {
-          spl[n] = qtempl[R_Y + n];
-        }
-        EOS::RYP2T(eos_state_rho, spl, eos_state_p, eos_state_T);
-        EOS::RYP2E(eos_state_rho, spl, eos_state_p, eos_state_e);
-        EOS::TY2G(eos_state_T, spl, eos_state_gamma);
-        EOS::RPY2Cs(eos_state_rho, eos_state_p, spl, eos_state_cs);
-        const amrex::Real rhoe_l = eos_state_rho * eos_state_e;
-        const amrex::Real gamc_l = eos_state_gamma;
-
-        eos_state_rho = qtempr[R_RHO];
-        eos_state_p = qtempr[R_P];
-        amrex::Real spr[NUM_SPECIES];
-        for (int n = 0; n < NUM_SPECIES; n++) {
-          spr[n] = qtempr[R_Y + n];
-        }
-        EOS::RYP2T(eos_state_rho, spr, eos_state_p, eos_state_T);
-        EOS::RYP2E(eos_state_rho, spr, eos_state_p, eos_state_e);
-        EOS::TY2G(eos_state_T, spr, eos_state_gamma);
-        EOS::RPY2Cs(eos_state_rho, eos_state_p, spr, eos_state_cs);
-        const amrex::Real rhoe_r = eos_state_rho * eos_state_e;
-        const amrex::Real gamc_r = eos_state_gamma;
-
-        amrex::Real flux_tmp[NVAR] = {0.0};
-        amrex::Real ustar = 0.0;
-
-        amrex::Real tmp0, tmp1, tmp2, tmp3, tmp4;
-        riemann(
-          qtempl[R_RHO], qtempl[R_UN], qtempl[R_UT1], qtempl[R_UT2],
-          qtempl[R_P], rhoe_l, spl, gamc_l, qtempr[R_RHO], qtempr[R_UN],
-          qtempr[R_UT1], qtempr[R_UT2], qtempr[R_P], rhoe_r, spr, gamc_r,
-          bc_test_val, csmall, cavg, ustar, flux_tmp[URHO], flux_tmp[f_idx[0]],
-          flux_tmp[f_idx[1]], flux_tmp[f_idx[2]], flux_tmp[UEDEN],
-          flux_tmp[UEINT], tmp0, tmp1, tmp2, tmp3, tmp4);
+    amrex::Real T_r, rhoe_r, gamc_r, cs_r;
+    amrex::Real spr[NUM_SPECIES];
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      spr[n] = qtempr[R_Y + n];
+    }
+    pc_face_eos(qtempr[R_RHO], qtempr[R_P], spr, T_r, rhoe_r, gamc_r, cs_r);
 
-        for (int n = 0; n < NUM_SPECIES; n++) {
-          flux_tmp[UFS + n] = (ustar > 0.0) ? flux_tmp[URHO] * qtempl[R_Y + n]
-                                            : flux_tmp[URHO] * qtempr[R_Y + n];
-          flux_tmp[UFS + n] =
-            (ustar == 0.0)
-              ? flux_tmp[URHO] * 0.5 * (qtempl[R_Y + n] + qtempr[R_Y + n])
-              : flux_tmp[UFS + n];
-        }
+    amrex::Real flux_tmp[NVAR] = {0.0};
+    amrex::Real ustar = 0.0;
 
-        flux_tmp[UTEMP] = 0.0;
-        for (int n = UFX; n < UFX + NUM_AUX; n++) {
-          flux_tmp[n] = (NUM_AUX > 0) ? 0.0 : flux_tmp[n];
-        }
-        for (int n = UFA; n < UFA + NUM_ADV; n++) {
-          flux_tmp[n] = (NUM_ADV > 0) ? 0.0 : flux_tmp[n];
-        }
+    amrex::Real tmp0, tmp1, tmp2, tmp3, tmp4;
+    pc_riemann<solver>(
+      qtempl[R_RHO], qtempl[R_UN], qtempl[R_UT1], qtempl[R_UT2], qtempl[R_P],
+      rhoe_l, spl, gamc_l, cs_l, qtempr[R_RHO], qtempr[R_UN], qtempr[R_UT1],
+      qtempr[R_UT2], qtempr[R_P], rhoe_r, spr, gamc_r, cs_r, bc_test_val,
+      csmall, cavg, ustar, flux_tmp[URHO], flux_tmp[f_idx[0]],
+      flux_tmp[f_idx[1]], flux_tmp[f_idx[2]], flux_tmp[UEDEN], flux_tmp[UEINT],
+      tmp0, tmp1, tmp2, tmp3, tmp4);
 
-        for (int ivar = 0; ivar < NVAR; ivar++) {
-          flx[dir](i, j, k, ivar) += flux_tmp[ivar] * a[dir](i, j, k);
-        }
-      });
+    for (int n = 0; n < NUM_SPECIES; n++) {
+      flux_tmp[UFS + n] = (ustar > 0.0) ? flux_tmp[URHO] * qtempl[R_Y + n]
+                                        : flux_tmp[URHO] * qtempr[R_Y + n];
+      flux_tmp[UFS + n] =
+        (ustar == 0.0)
+          ? flux_tmp[URHO] * 0.5 * (qtempl[R_Y + n] + qtempr[R_Y + n])
+          : flux_tmp[UFS + n];
+    }
+
+    flux_tmp[UTEMP] = 0.0;
+    for (int n = UFX; n < UFX + NUM_AUX; n++) {
+      flux_tmp[n] = (NUM_AUX > 0) ? 0.0 : flux_tmp[n];
+    }
+    for (int n = UFA; n < UFA + NUM_ADV; n++) {
+      flux_tmp[n] = (NUM_ADV > 0) ? 0.0 : flux_tmp[n];
+    }
+
+    for (int ivar = 0; ivar < NVAR; ivar++) {
+      flx(i, j, k, ivar) += flux_tmp[ivar] * a(i, j, k);
+    }
+  });
+}
+
+template <int solver, int order>
+void
+hyp_mol_face_fluxes(
+  const amrex::Box& cbox,
+  const amrex::Array4<const amrex::Real>& q,
+  const amrex::Array4<const amrex::Real>& qaux,
+  const amrex::Array4<amrex::Real>& dq,
+  const amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx,
+  const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
+    a
+#ifdef PELEC_USE_EB
+  ,
+  const amrex::Array4<amrex::EBCellFlag const>& flags
+#endif
+)
+{
+  hyp_mol_flux_dir<solver, 0, order>(
+    cbox, q, qaux, dq, flx[0], a[0]
+#ifdef PELEC_USE_EB
+    ,
+    flags
+#endif
+  );
+#if AMREX_SPACEDIM > 1
+  hyp_mol_flux_dir<solver, 1, order>(
+    cbox, q, qaux, dq, flx[1], a[1]
+#ifdef PELEC_USE_EB
+    ,
+    flags
+#endif
+  );
+#endif
+#if AMREX_SPACEDIM == 3
+  hyp_mol_flux_dir<solver, 2, order>(
+    cbox, q, qaux, dq, flx[2], a[2]
+#ifdef PELEC_USE_EB
+    ,
+    flags
+#endif
+  );
+#endif
+}
+
+template <int solver>
+void
+hyp_mol_flux(
+  const amrex::Box& cbox,
+  const amrex::Array4<const amrex::Real>& q,
+  const amrex::Array4<const amrex::Real>& qaux,
+  const amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx,
+  const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
+    a,
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
+  const int plm_iorder
+#ifdef PELEC_USE_EB
+  ,
+  const amrex::Real eb_small_vfrac,
+  const amrex::Array4<const amrex::Real>& vfrac,
+  const amrex::Array4<amrex::EBCellFlag const>& flags,
+  const EBBndryGeom* ebg,
+  const int Nebg,
+  amrex::Real* ebflux,
+  const int nebflux
+#endif
+)
+{
+  // Slopes, reused for all directions
+  amrex::FArrayBox dq_fab = ScratchArena::get().fab(cbox, QVAR);
+  amrex::Elixir dq_fab_eli = dq_fab.elixir();
+  auto const& dq = dq_fab.array();
+
+  // The slopes of each direction overwrite those of the previous one, and
+  // first order reconstructions do not use them
+  if (plm_iorder == 1) {
+    hyp_mol_face_fluxes<solver, 1>(
+      cbox, q, qaux, dq, flx, a
+#ifdef PELEC_USE_EB
+      ,
+      flags
+#endif
+    );
+  } else {
+    hyp_mol_face_fluxes<solver, 2>(
+      cbox, q, qaux, dq, flx, a
+#ifdef PELEC_USE_EB
+      ,
+      flags
+#endif
+    );
   }
 
 #ifdef PELEC_USE_EB
+  const int R_RHO = 0;
+  const int R_UN = 1;
+  const int R_UT1 = 2;
+  const int R_UT2 = 3;
+  const int R_P = 4;
+  const int R_Y = 5;
+  const int bc_test_val = 1;
+
   // nextra was 3 for EB in PeleC but we are operating on a different
   // box here, so this should be zero.
   const int nextra = 0;
@@ -198,7 +275,7 @@ pc_compute_hyp_mol_flux(
     amrex::Real qtempl[5 + NUM_SPECIES] = {0.0};
     amrex::Real qtempr[5 + NUM_SPECIES] = {0.0};
     amrex::Real cavg = 0.0, csmall = 0.0, cspeed = 0.0, rhoe_l = 0.0,
-                gamc_l = 0.0;
+                gamc_l = 0.0, cs_l = 0.0;
     amrex::Real spl[NUM_SPECIES] = {0.0};
     amrex::Real flux_tmp[NVAR] = {0.0};
     amrex::Real ebnorm[AMREX_SPACEDIM] = {AMREX_D_DECL(
@@ -291,26 +368,20 @@ pc_compute_hyp_mol_flux(
         qtempr[R_UN] = -1.0 * qtempl[R_UN];
       }
 
-      amrex::Real eos_state_rho = qtempl[R_RHO];
-      amrex::Real eos_state_p = qtempl[R_P];
       for (int n = 0; n < NUM_SPECIES; n++) {
         spl[n] = qtempl[R_Y + n];
       }
-      amrex::Real eos_state_e;
-      EOS::RYP2E(eos_state_rho, spl, eos_state_p, eos_state_e);
-      rhoe_l = eos_state_rho * eos_state_e;
-      amrex::Real eos_state_T;
-      EOS::RYP2T(eos_state_rho, spl, eos_state_p, eos_state_T);
-      EOS::TY2G(eos_state_T, spl, gamc_l);
+      amrex::Real T_l;
+      pc_face_eos(qtempl[R_RHO], qtempl[R_P], spl, T_l, rhoe_l, gamc_l, cs_l);
     }
 
     if (is_inside(i, j, k, lo, hi, nextra - 1)) {
       amrex::Real tmp0, tmp1, tmp2, tmp3, tmp4, ustar = 0.0;
-      riemann(
+      pc_riemann<solver>(
         qtempl[R_RHO], qtempl[R_UN], qtempl[R_UT1], qtempl[R_UT2], qtempl[R_P],
-        rhoe_l, spl, gamc_l, qtempl[R_RHO], qtempr[R_UN], qtempl[R_UT1],
-        qtempl[R_UT2], qtempl[R_P], rhoe_l, spl, gamc_l, bc_test_val, csmall,
-        cavg, ustar, flux_tmp[URHO], flux_tmp[UMX], flux_tmp[UMY],
+        rhoe_l, spl, gamc_l, cs_l, qtempl[R_RHO], qtempr[R_UN], qtempl[R_UT1],
+        qtempl[R_UT2], qtempl[R_P], rhoe_l, spl, gamc_l, cs_l, bc_test_val,
+        csmall, cavg, ustar, flux_tmp[URHO], flux_tmp[UMX], flux_tmp[UMY],
         flux_tmp[UMZ], flux_tmp[UEDEN], flux_tmp[UEINT], tmp0, tmp1, tmp2, tmp3,
         tmp4);
 
@@ -332,3 +403,39 @@ pc_compute_hyp_mol_flux(
   });
 #endif
 }
+
+} // namespace
+
+void
+pc_compute_hyp_mol_flux(
+  const amrex::Box& cbox,
+  const amrex::Array4<const amrex::Real>& q,
+  const amrex::Array4<const amrex::Real>& qaux,
+  const amrex::GpuArray<amrex::Array4<amrex::Real>, AMREX_SPACEDIM> flx,
+  const amrex::GpuArray<const amrex::Array4<const amrex::Real>, AMREX_SPACEDIM>
+    a,
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> del,
+  const int plm_iorder,
+  const int riemann_solver
+#ifdef PELEC_USE_EB
+  ,
+  const amrex::Real eb_small_vfrac,
+  const amrex::Array4<const amrex::Real>& vfrac,
+  const amrex::Array4<amrex::EBCellFlag const>& flags,
+  const EBBndryGeom* ebg,
+  const int Nebg,
+  amrex::Real* ebflux,
+  const int nebflux
+#endif
+)
+{
+  pc_riemann_dispatch(riemann_solver, [&](auto rs) {
+    hyp_mol_flux<decltype(rs)::value>(
+      cbox, q, qaux, flx, a, del, plm_iorder
+#ifdef PELEC_USE_EB
+      ,
+      eb_small_vfrac, vfrac, flags, ebg, Nebg, ebflux, nebflux
+#endif
+    );
+  });
+}
@@ -0,0 +1,52 @@
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#include "MOLTileTuner.H"
+
+amrex::IntVect
+MOLTileTuner::next() const
+{
+  return m_done ? m_best : m_candidates[m_current];
+}
+
+void
+MOLTileTuner::record(
+  amrex::Real time_per_cell, const int level, const int verbose)
+{
+  if (m_done) {
+    return;
+  }
+
+  // The first call of each candidate only warms it up
+  amrex::ParallelDescriptor::ReduceRealMax(time_per_cell);
+  if (m_calls == 0) {
+    m_cost.push_back(0.0);
+  } else {
+    m_cost[m_current] += time_per_cell / nsamples;
+  }
+  if (++m_calls <= nsamples) {
+    return;
+  }
+  m_calls = 0;
+  if (++m_current < m_candidates.size()) {
+    return;
+  }
+
+  int ibest = 0;
+  for (int n = 1; n < m_candidates.size(); ++n) {
+    if (m_cost[n] < m_cost[ibest]) {
+      ibest = n;
+    }
+  }
+  m_best = m_candidates[ibest];
+  m_done = true;
+  if (verbose) {
+    amrex::Print() << "MOL tile size auto-tuning on level " << level
+                   << " (average of " << nsamples << " calls):" << std::endl;
+    for (int n = 0; n < m_candidates.size(); ++n) {
+      amrex::Print() << "  " << m_candidates[n] << " : " << m_cost[n]
+                     << " s/cell" << std::endl;
+    }
+    amrex::Print() << "  using " << m_best << std::endl;
+  }
+}
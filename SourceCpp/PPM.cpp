@@ -1,18 +1,21 @@
 #include "Godunov.H"
 #include "PPM.H"
 
+namespace {
+
+// Body of trace_ppm, with the direction and the flattening switch known at
+// compile time so that the kernel carries no branches on them
+template <int idir, int use_flattening>
 void
-trace_ppm(
+trace_ppm_dir(
   const amrex::Box& bx,
-  const int idir,
   amrex::Array4<amrex::Real const> const& q_arr,
   amrex::Array4<amrex::Real const> const& /*srcQ*/,
   amrex::Array4<amrex::Real> const& qm,
   amrex::Array4<amrex::Real> const& qp,
   const amrex::Box& vbx,
   const amrex::Real dt,
-  const amrex::Real* dx,
-  const int use_flattening)
+  const amrex::Real* dx)
 {
 
   // here, lo and hi are the range we loop over -- this can include ghost cells
@@ -61,24 +64,16 @@ trace_ppm(
   // jumps that are moving toward the interface to the reference
   // state to get the full state on that interface.
 
-  int QUN, QUT, QUTT;
-
-  if (idir == 0) {
-    QUN = QU;
-    QUT = QV;
-    QUTT = QW;
-  } else if (idir == 1) {
-    QUN = QV;
-    QUT = QW;
-    QUTT = QU;
-  } else if (idir == 2) {
-    QUN = QW;
-    QUT = QU;
-    QUTT = QV;
-  }
+  constexpr int QUN = idir == 0 ? QU : (idir == 1 ? QV : QW);
+  constexpr int QUT = idir == 0 ? QV : (idir == 1 ? QW : QU);
+  constexpr int QUTT = idir == 0 ? QW : (idir == 1 ? QU : QV);
+  constexpr int bdim[3] = {idir == 0, idir == 1, idir == 2};
 
   // Trace to left and right edges using upwind PPM
   amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+    // Index of the cell along idir
+    const int ic = idir == 0 ? i : (idir == 1 ? j : k);
+
     amrex::Real rho = q_arr(i, j, k, QRHO);
 
     amrex::Real massfrac[NUM_SPECIES];
@@ -97,9 +92,13 @@ trace_ppm(
     amrex::Real flat = 1.0;
     // Calculate flattening in-place
     if (use_flattening == 1) {
-      for (int dir_flat = 0; dir_flat < AMREX_SPACEDIM; dir_flat++) {
-        flat = amrex::min(flat, flatten(i, j, k, dir_flat, q_arr));
-      }
+      flat = amrex::min(flat, flatten<0>(i, j, k, q_arr));
+#if AMREX_SPACEDIM > 1
+      flat = amrex::min(flat, flatten<1>(i, j, k, q_arr));
+#endif
+#if AMREX_SPACEDIM == 3
+      flat = amrex::min(flat, flatten<2>(i, j, k, q_arr));
+#endif
     }
 
     amrex::Real sm;
@@ -109,28 +108,11 @@ trace_ppm(
     amrex::Real Im[QVAR][3];
 
     for (int n = 0; n < QVAR; n++) {
-
-      if (idir == 0) {
-        s[im2] = q_arr(i - 2, j, k, n);
-        s[im1] = q_arr(i - 1, j, k, n);
-        s[i0] = q_arr(i, j, k, n);
-        s[ip1] = q_arr(i + 1, j, k, n);
-        s[ip2] = q_arr(i + 2, j, k, n);
-
-      } else if (idir == 1) {
-        s[im2] = q_arr(i, j - 2, k, n);
-        s[im1] = q_arr(i, j - 1, k, n);
-        s[i0] = q_arr(i, j, k, n);
-        s[ip1] = q_arr(i, j + 1, k, n);
-        s[ip2] = q_arr(i, j + 2, k, n);
-
-      } else {
-        s[im2] = q_arr(i, j, k - 2, n);
-        s[im1] = q_arr(i, j, k - 1, n);
-        s[i0] = q_arr(i, j, k, n);
-        s[ip1] = q_arr(i, j, k + 1, n);
-        s[ip2] = q_arr(i, j, k + 2, n);
-      }
+      s[im2] = q_arr(i - 2 * bdim[0], j - 2 * bdim[1], k - 2 * bdim[2], n);
+      s[im1] = q_arr(i - bdim[0], j - bdim[1], k - bdim[2], n);
+      s[i0] = q_arr(i, j, k, n);
+      s[ip1] = q_arr(i + bdim[0], j + bdim[1], k + bdim[2], n);
+      s[ip2] = q_arr(i + 2 * bdim[0], j + 2 * bdim[1], k + 2 * bdim[2], n);
 
       ppm_reconstruct(s, flat, sm, sp);
       ppm_int_profile(sm, sp, s[i0], un, cc, dtdx, Ip[n], Im[n]);
@@ -181,9 +163,7 @@ trace_ppm(
     for (int n = QFS; n < NUM_SPECIES + QFS; n++) {
 
       // Plus state on face i
-      if (
-        (idir == 0 && i >= vlo[0]) || (idir == 1 && j >= vlo[1]) ||
-        (idir == 2 && k >= vlo[2])) {
+      if (ic >= vlo[idir]) {
 
         // We have
         //
@@ -198,22 +178,14 @@ trace_ppm(
       }
 
       // Minus state on face i+1
-      if (idir == 0 && i <= vhi[0]) {
-        qm(i + 1, j, k, n) = Ip[n][1];
-
-      } else if (idir == 1 && j <= vhi[1]) {
-        qm(i, j + 1, k, n) = Ip[n][1];
-
-      } else if (idir == 2 && k <= vhi[2]) {
-        qm(i, j, k + 1, n) = Ip[n][1];
+      if (ic <= vhi[idir]) {
+        qm(i + bdim[0], j + bdim[1], k + bdim[2], n) = Ip[n][1];
       }
     }
 
     // plus state on face i
 
-    if (
-      (idir == 0 && i >= vlo[0]) || (idir == 1 && j >= vlo[1]) ||
-      (idir == 2 && k >= vlo[2])) {
+    if (ic >= vlo[idir]) {
 
       // Set the reference state
       // This will be the fastest moving state to the left --
@@ -308,9 +280,7 @@ trace_ppm(
 
     // minus state on face i + 1
 
-    if (
-      (idir == 0 && i <= vhi[0]) || (idir == 1 && j <= vhi[1]) ||
-      (idir == 2 && k <= vhi[2])) {
+    if (ic <= vhi[idir]) {
 
       // Set the reference state
       // This will be the fastest moving state to the right
@@ -370,78 +340,72 @@ trace_ppm(
       // The final interface states are just
       // q_s = q_ref - sum (l . dq) r
       // note that the a{mpz}left as defined above have the minus already
-      if (idir == 0) {
-        qm(i + 1, j, k, QRHO) =
-          amrex::max(SMALL_DENS, rho_ref + alphap + alpham + alpha0r);
-        qm(i + 1, j, k, QUN) =
-          un_ref + (alphap - alpham) * cc_ref * rho_ref_inv;
-        // qm(i+1,j,k,QREINT) = rhoe_g_ref + (alphap + alpham)*h_g_ref +
-        // alpha0e_g;
-        qm(i + 1, j, k, QPRES) =
-          amrex::max(SMALL_PRES, p_ref + (alphap + alpham) * csq_ref);
-
-        // transverse velocities
-        qm(i + 1, j, k, QUT) = Ip[QUT][1] /*+ hdt * Ip_src[QUT][1]*/;
-        qm(i + 1, j, k, QUTT) = Ip[QUTT][1] /*+ hdt * Ip_src[QUTT][1]*/;
-
-        // This allows the (rho e) to take advantage of (pressure >
-        // small_pres)
-        amrex::Real eint = 0;
-        amrex::Real massfrac_m[NUM_SPECIES];
-        for (int sp = 0; sp < NUM_SPECIES; ++sp)
-          massfrac_m[sp] = qm(i + 1, j, k, sp + QFS);
-        EOS::RYP2E(
-          qm(i + 1, j, k, QRHO), massfrac_m, qm(i + 1, j, k, QPRES), eint);
-        qm(i + 1, j, k, QREINT) = qm(i + 1, j, k, QRHO) * eint;
-
-      } else if (idir == 1) {
-        qm(i, j + 1, k, QRHO) =
-          amrex::max(SMALL_DENS, rho_ref + alphap + alpham + alpha0r);
-        qm(i, j + 1, k, QUN) =
-          un_ref + (alphap - alpham) * cc_ref * rho_ref_inv;
-        // qm(i,j+1,k,QREINT) = rhoe_g_ref + (alphap + alpham)*h_g_ref +
-        // alpha0e_g;
-        qm(i, j + 1, k, QPRES) =
-          amrex::max(SMALL_PRES, p_ref + (alphap + alpham) * csq_ref);
-
-        // transverse velocities
-        qm(i, j + 1, k, QUT) = Ip[QUT][1] /*+ hdt * Ip_src[QUT][1]*/;
-        qm(i, j + 1, k, QUTT) = Ip[QUTT][1] /*+ hdt * Ip_src[QUTT][1]*/;
-
-        // This allows the (rho e) to take advantage of (pressure >
-        // small_pres)
-        amrex::Real eint = 0;
-        amrex::Real massfrac_m[NUM_SPECIES];
-        for (int sp = 0; sp < NUM_SPECIES; ++sp)
-          massfrac_m[sp] = qm(i, j + 1, k, sp + QFS);
-        EOS::RYP2E(
-          qm(i, j + 1, k, QRHO), massfrac_m, qm(i, j + 1, k, QPRES), eint);
-        qm(i, j + 1, k, QREINT) = qm(i, j + 1, k, QRHO) * eint;
-
-      } else if (idir == 2) {
-        qm(i, j, k + 1, QRHO) =
-          amrex::max(SMALL_DENS, rho_ref + alphap + alpham + alpha0r);
-        qm(i, j, k + 1, QUN) =
-          un_ref + (alphap - alpham) * cc_ref * rho_ref_inv;
-        // qm(i,j,k+1,QREINT) = rhoe_g_ref + (alphap + alpham)*h_g_ref +
-        // alpha0e_g;
-        qm(i, j, k + 1, QPRES) =
-          amrex::max(SMALL_PRES, p_ref + (alphap + alpham) * csq_ref);
-
-        // transverse velocities
-        qm(i, j, k + 1, QUT) = Ip[QUT][1] /*+ hdt * Ip_src[QUT][1]*/;
-        qm(i, j, k + 1, QUTT) = Ip[QUTT][1] /*+ hdt * Ip_src[QUTT][1]*/;
-
-        // This allows the (rho e) to take advantage of (pressure >
-        // small_pres)
-        amrex::Real eint = 0;
-        amrex::Real massfrac_m[NUM_SPECIES];
-        for (int sp = 0; sp < NUM_SPECIES; ++sp)
-          massfrac_m[sp] = qm(i, j, k + 1, sp + QFS);
-        EOS::RYP2E(
-          qm(i, j, k + 1, QRHO), massfrac_m, qm(i, j, k + 1, QPRES), eint);
-        qm(i, j, k + 1, QREINT) = qm(i, j, k + 1, QRHO) * eint;
-      }
+      const int ii = i + bdim[0];
+      const int jj = j + bdim[1];
+      const int kk = k + bdim[2];
+      qm(ii, jj, kk, QRHO) =
+        amrex::max(SMALL_DENS, rho_ref + alphap + alpham + alpha0r);
+      qm(ii, jj, kk, QUN) = un_ref + (alphap - alpham) * cc_ref * rho_ref_inv;
+      // qm(ii,jj,kk,QREINT) = rhoe_g_ref + (alphap + alpham)*h_g_ref +
+      // alpha0e_g;
+      qm(ii, jj, kk, QPRES) =
+        amrex::max(SMALL_PRES, p_ref + (alphap + alpham) * csq_ref);
+
+      // transverse velocities
+      qm(ii, jj, kk, QUT) = Ip[QUT][1] /*+ hdt * Ip_src[QUT][1]*/;
+      qm(ii, jj, kk, QUTT) = Ip[QUTT][1] /*+ hdt * Ip_src[QUTT][1]*/;
+
+      // This allows the (rho e) to take advantage of (pressure > small_pres)
+      amrex::Real eint = 0;
+      amrex::Real massfrac_m[NUM_SPECIES];
+      for (int sp = 0; sp < NUM_SPECIES; ++sp)
+        massfrac_m[sp] = qm(ii, jj, kk, sp + QFS);
+      EOS::RYP2E(qm(ii, jj, kk, QRHO), massfrac_m, qm(ii, jj, kk, QPRES), eint);
+      qm(ii, jj, kk, QREINT) = qm(ii, jj, kk, QRHO) * eint;
     }
   });
 }
+
+template <int use_flattening>
+void
+trace_ppm_flat(
+  const amrex::Box& bx,
+  const int idir,
+  amrex::Array4<amrex::Real const> const& q_arr,
+  amrex::Array4<amrex::Real const> const& srcQ,
+  amrex::Array4<amrex::Real> const& qm,
+  amrex::Array4<amrex::Real> const& qp,
+  const amrex::Box& vbx,
+  const amrex::Real dt,
+  const amrex::Real* dx)
+{
+  if (idir == 0) {
+    trace_ppm_dir<0, use_flattening>(bx, q_arr, srcQ, qm, qp, vbx, dt, dx);
+  } else if (idir == 1) {
+    trace_ppm_dir<1, use_flattening>(bx, q_arr, srcQ, qm, qp, vbx, dt, dx);
+  } else {
+    trace_ppm_dir<2, use_flattening>(bx, q_arr, srcQ, qm, qp, vbx, dt, dx);
+  }
+}
+
+} // namespace
+
+void
+trace_ppm(
+  const amrex::Box& bx,
+  const int idir,
+  amrex::Array4<amrex::Real const> const& q_arr,
+  amrex::Array4<amrex::Real const> const& srcQ,
+  amrex::Array4<amrex::Real> const& qm,
+  amrex::Array4<amrex::Real> const& qp,
+  const amrex::Box& vbx,
+  const amrex::Real dt,
+  const amrex::Real* dx,
+  const int use_flattening)
+{
+  if (use_flattening == 1) {
+    trace_ppm_flat<1>(bx, idir, q_arr, srcQ, qm, qp, vbx, dt, dx);
+  } else {
+    trace_ppm_flat<0>(bx, idir, q_arr, srcQ, qm, qp, vbx, dt, dx);
+  }
+}
@@ -30,6 +30,8 @@ using namespace MASA;
 #include "Timestep.H"
 #include "Utilities.H"
 #include "Tagging.H"
+#include "ScratchArena.H"
+#include "Riemann.H"
 #include "IndexDefines.H"
 #ifdef USE_SUNDIALS_PP
 #include <reactor.h>
@@ -62,11 +64,17 @@ int PeleC::pstateNum = 0;
 #include "pelec_defaults.H"
 
 int PeleC::nGrowTr = 4;
+amrex::IntVect PeleC::mol_tile_size(AMREX_D_DECL(0, 0, 0));
 int PeleC::diffuse_temp = 0;
 int PeleC::diffuse_enth = 0;
 int PeleC::diffuse_spec = 0;
 int PeleC::diffuse_vel = 0;
 amrex::Real PeleC::diffuse_cutoff_density = -1.e200;
+long long PeleC::transport_cache_hits = 0;
+long long PeleC::transport_cache_misses = 0;
+amrex::Real PeleC::transport_cache_max_err = 0.0;
+amrex::Real PeleC::overlap_transport_time = 0.0;
+amrex::Real PeleC::overlap_wait_time = 0.0;
 bool PeleC::do_diffuse = false;
 
 #ifdef PELEC_USE_MASA
@@ -78,6 +86,7 @@ int PeleC::les_filter_type = no_filter;
 int PeleC::les_filter_fgr = 1;
 int PeleC::les_test_filter_type = box_3pt_optimized_approx;
 int PeleC::les_test_filter_fgr = 2;
+int PeleC::les_coeff_update_interval = 1;
 
 #ifdef PELEC_USE_EB
 bool PeleC::eb_initialized = false;
@@ -117,6 +126,16 @@ ebInitialized(bool eb_init_val)
 void
 PeleC::variableCleanUp()
 {
+  if (verbose) {
+    ScratchArena::print_stats();
+  }
+  if (verbose && mol_transport_cache) {
+    print_transport_cache_stats();
+  }
+  if (verbose && mol_overlap_comm) {
+    print_overlap_stats();
+  }
+
   desc_lst.clear();
 
   transport_close();
@@ -154,6 +173,14 @@ PeleC::read_params()
   pp.query("sum_interval", sum_interval);
   pp.query("dump_old", dump_old);
 
+  amrex::Vector<int> tile_size;
+  if (pp.queryarr("mol_tile_size", tile_size)) {
+    if (tile_size.size() != AMREX_SPACEDIM) {
+      amrex::Error("PeleC::mol_tile_size needs one entry per direction");
+    }
+    mol_tile_size = amrex::IntVect(tile_size);
+  }
+
   // Get boundary conditions
   amrex::Vector<std::string> lo_bc_char(AMREX_SPACEDIM);
   amrex::Vector<std::string> hi_bc_char(AMREX_SPACEDIM);
@@ -275,6 +302,10 @@ PeleC::read_params()
     pp.query("les_model", les_model);
     pp.query("les_test_filter_type", les_test_filter_type);
     pp.query("les_test_filter_fgr", les_test_filter_fgr);
+    pp.query("les_coeff_update_interval", les_coeff_update_interval);
+    if (les_coeff_update_interval < 1) {
+      amrex::Error("PeleC::les_coeff_update_interval must be at least 1");
+    }
   }
 
   if (use_explicit_filter) {
@@ -319,6 +350,28 @@ PeleC::read_params()
     amrex::Error("use_colglaz is deprecated. Use riemann_solver instead");
   }
 
+  if (
+    riemann_solver != riemann_cgf && riemann_solver != riemann_hllc &&
+    riemann_solver != riemann_hll) {
+    amrex::Error("PeleC::riemann_solver must be 0 (CGF), 2 (HLLC) or 4 (HLL)");
+  }
+
+  if (mol_rk_scheme < 2 || mol_rk_scheme > 4) {
+    amrex::Error("PeleC::mol_rk_scheme must be 2, 3 or 4");
+  }
+
+  if (mol_rk_scheme != 2 && mol_iters > 1) {
+    amrex::Error("PeleC::mol_iters > 1 requires mol_rk_scheme = 2");
+  }
+
+  if (mol_transport_cache && !do_mol) {
+    amrex::Error("PeleC::mol_transport_cache requires do_mol = 1");
+  }
+
+  if (mol_overlap_comm && !do_mol) {
+    amrex::Error("PeleC::mol_overlap_comm requires do_mol = 1");
+  }
+
   if (max_dt < fixed_dt) {
     amrex::Error("Cannot have max_dt < fixed_dt");
   }
@@ -648,6 +701,9 @@ PeleC::initData()
     get_new_data(Work_Estimate_Type).setVal(1.0);
   }
 
+  // Allow the user to set up the data needed by the grids of this level
+  problem_pre_init_data();
+
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
@@ -785,8 +841,6 @@ PeleC::estTimeStep(amrex::Real dt_old)
 
   const amrex::MultiFab& stateMF = get_new_data(State_Type);
 
-  const amrex::Real* dx = geom.CellSize();
-
   std::string limiter = "pelec.max_dt";
 
   // Start the hydro with the max_dt value, but divide by CFL
@@ -795,9 +849,6 @@ PeleC::estTimeStep(amrex::Real dt_old)
   // criterion, we will get exactly max_dt for a timestep.
 
   amrex::Real estdt_hydro = max_dt / cfl;
-  amrex::Real estdt_vdif = max_dt / cfl;
-  amrex::Real estdt_tdif = max_dt / cfl;
-  amrex::Real estdt_edif = max_dt / cfl;
   if (do_hydro || do_mol || diffuse_vel || diffuse_temp || diffuse_enth) {
 
 #ifdef PELEC_USE_EB
@@ -807,118 +858,77 @@ PeleC::estTimeStep(amrex::Real dt_old)
 #endif
 
     prefetchToDevice(stateMF); // This should accelerate the below operations.
-    amrex::Real AMREX_D_DECL(dx1 = dx[0], dx2 = dx[1], dx3 = dx[2]);
-
-    if (do_hydro) {
-      amrex::Real dt = amrex::ReduceMin(
-        stateMF,
-#ifdef PELEC_USE_EB
-        flags,
-#endif
-        0,
-        [=] AMREX_GPU_HOST_DEVICE(
-          amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
-#ifdef PELEC_USE_EB
-          ,
-          const amrex::Array4<const amrex::EBCellFlag>& flag_arr
-#endif
-          ) noexcept -> amrex::Real {
-          return pc_estdt_hydro(
-            bx, fab_arr,
-#ifdef PELEC_USE_EB
-            flag_arr,
-#endif
-            AMREX_D_DECL(dx1, dx2, dx3));
-        });
-      estdt_hydro = amrex::min(estdt_hydro, dt);
-    }
-
-    if (diffuse_vel) {
-      amrex::Real dt = amrex::ReduceMin(
-        stateMF,
-#ifdef PELEC_USE_EB
-        flags,
-#endif
-        0,
-        [=] AMREX_GPU_HOST_DEVICE(
-          amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
-#ifdef PELEC_USE_EB
-          ,
-          const amrex::Array4<const amrex::EBCellFlag>& flag_arr
-#endif
-          ) noexcept -> amrex::Real {
-          return pc_estdt_veldif(
-            bx, fab_arr,
-#ifdef PELEC_USE_EB
-            flag_arr,
-#endif
-            AMREX_D_DECL(dx1, dx2, dx3));
-        });
-      estdt_vdif = amrex::min(estdt_vdif, dt);
-    }
-
-    if (diffuse_temp) {
-      amrex::Real dt = amrex::ReduceMin(
-        stateMF,
-#ifdef PELEC_USE_EB
-        flags,
+    const auto dxa = geom.CellSizeArray();
+    const bool hydro_lim = do_hydro;
+    const bool vdif_lim = diffuse_vel;
+    const bool tdif_lim = diffuse_temp;
+    const bool edif_lim = diffuse_enth;
+
+    // All the limits are computed in a single pass over the state
+    amrex::ReduceOps<
+      amrex::ReduceOpMin, amrex::ReduceOpMin, amrex::ReduceOpMin,
+      amrex::ReduceOpMin>
+      reduce_op;
+    amrex::ReduceData<amrex::Real, amrex::Real, amrex::Real, amrex::Real>
+      reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-        0,
-        [=] AMREX_GPU_HOST_DEVICE(
-          amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
+    for (amrex::MFIter mfi(stateMF, amrex::TilingIfNotGPU()); mfi.isValid();
+         ++mfi) {
+      const amrex::Box& bx = mfi.tilebox();
+      auto const& u = stateMF.const_array(mfi);
 #ifdef PELEC_USE_EB
-          ,
-          const amrex::Array4<const amrex::EBCellFlag>& flag_arr
-#endif
-          ) noexcept -> amrex::Real {
-          return pc_estdt_tempdif(
-            bx, fab_arr,
+      auto const& flag_arr = flags[mfi].const_array();
+#endif
+      reduce_op.eval(
+        bx, reduce_data,
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept -> ReduceTuple {
+          amrex::Real dt_hydro = std::numeric_limits<amrex::Real>::max();
+          amrex::Real dt_vdif = dt_hydro, dt_tdif = dt_hydro,
+                      dt_edif = dt_hydro;
 #ifdef PELEC_USE_EB
-            flag_arr,
+          if (flag_arr(i, j, k).isCovered()) {
+            return {dt_hydro, dt_vdif, dt_tdif, dt_edif};
+          }
 #endif
-            AMREX_D_DECL(dx1, dx2, dx3));
+          pc_estdt_cell(
+            i, j, k, u, dxa, hydro_lim, vdif_lim, tdif_lim, edif_lim, dt_hydro,
+            dt_vdif, dt_tdif, dt_edif);
+          return {dt_hydro, dt_vdif, dt_tdif, dt_edif};
         });
-      estdt_tdif = amrex::min(estdt_tdif, dt);
     }
 
-    if (diffuse_enth) {
-      amrex::Real dt = amrex::ReduceMin(
-        stateMF,
-#ifdef PELEC_USE_EB
-        flags,
-#endif
-        0,
-        [=] AMREX_GPU_HOST_DEVICE(
-          amrex::Box const& bx, const amrex::Array4<const amrex::Real>& fab_arr
-#ifdef PELEC_USE_EB
-          ,
-          const amrex::Array4<const amrex::EBCellFlag>& flag_arr
-#endif
-          ) noexcept -> amrex::Real {
-          return pc_estdt_enthdif(
-            bx, fab_arr,
-#ifdef PELEC_USE_EB
-            flag_arr,
-#endif
-            AMREX_D_DECL(dx1, dx2, dx3));
-        });
-      estdt_edif = amrex::min(estdt_edif, dt);
+    ReduceTuple hv = reduce_data.value();
+    amrex::Real estdt_lim[4] = {
+      amrex::min(estdt_hydro, amrex::get<0>(hv)),
+      amrex::min(estdt_hydro, amrex::get<1>(hv)),
+      amrex::min(estdt_hydro, amrex::get<2>(hv)),
+      amrex::min(estdt_hydro, amrex::get<3>(hv))};
+    amrex::ParallelDescriptor::ReduceRealMin(estdt_lim, 4);
+
+    const std::string lim_names[4] = {
+      "hydro", "viscous diffusion", "thermal diffusion",
+      "enthalpy diffusion"};
+    std::string hydro_limiter = "hydro";
+    for (int n = 0; n < 4; ++n) {
+      if (estdt_lim[n] < estdt_hydro) {
+        estdt_hydro = estdt_lim[n];
+        hydro_limiter = lim_names[n];
+      }
     }
-
-    estdt_hydro = amrex::min(
-      estdt_hydro, amrex::min(estdt_vdif, amrex::min(estdt_tdif, estdt_edif)));
-
-    amrex::ParallelDescriptor::ReduceRealMin(estdt_hydro);
     estdt_hydro *= cfl;
 
     if (verbose) {
       amrex::Print() << "...estimated hydro-limited timestep at level " << level
-                     << ": " << estdt_hydro << std::endl;
+                     << ": " << estdt_hydro << " (" << hydro_limiter
+                     << "-limited)" << std::endl;
     }
 
     // Determine if this is more restrictive than the maximum timestep limiting
     if (estdt_hydro < estdt) {
-      limiter = "hydro";
+      limiter = hydro_limiter;
       estdt = estdt_hydro;
     }
   }
@@ -1515,238 +1525,273 @@ PeleC::removeOldData()
   AmrLevel::removeOldData();
 }
 
+// Tag cells of one component of field that exceed err (below level
+// max_err_lev) or whose jump to a neighbor exceeds grad (below level
+// max_grad_lev). With abs_err the magnitude of the field is tested.
+static void
+pc_tag_field(
+  amrex::TagBoxArray& tags,
+  const amrex::MultiFab& field,
+  const int comp,
+  const int level,
+  const amrex::Real err,
+  const int max_err_lev,
+  const amrex::Real grad,
+  const int max_grad_lev,
+  const bool abs_err = false)
+{
+  const char tagval = amrex::TagBox::SET;
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(field, amrex::TilingIfNotGPU()); mfi.isValid();
+       ++mfi) {
+    const amrex::Box& tilebox = mfi.tilebox();
+    const amrex::Array4<const amrex::Real> farr(field.array(mfi), comp, 1);
+    auto tag_arr = tags.array(mfi);
+
+    if (level < max_err_lev) {
+      if (abs_err) {
+        amrex::ParallelFor(
+          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            tag_abserror(i, j, k, tag_arr, farr, err, tagval);
+          });
+      } else {
+        amrex::ParallelFor(
+          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            tag_error(i, j, k, tag_arr, farr, err, tagval);
+          });
+      }
+    }
+    if (level < max_grad_lev) {
+      amrex::ParallelFor(
+        tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          tag_graderror(i, j, k, tag_arr, farr, grad, tagval);
+        });
+    }
+  }
+}
+
 void
 PeleC::errorEst(
   amrex::TagBoxArray& tags,
   int /*clearval*/,
   int /*tagval*/,
   amrex::Real time,
-  int n_error_buf,
-  int ngrow)
+  int /*n_error_buf*/,
+  int /*ngrow*/)
 {
   BL_PROFILE("PeleC::errorEst()");
 
+  // Wall time of each tagging stage, reported when verbose
+  amrex::Vector<std::string> stage_names;
+  amrex::Vector<amrex::Real> stage_times;
+  amrex::Real stage_start = amrex::ParallelDescriptor::second();
+  auto end_stage = [&](const std::string& name) {
+    if (verbose) {
+      amrex::Gpu::streamSynchronize();
+      const amrex::Real now = amrex::ParallelDescriptor::second();
+      stage_names.push_back(name);
+      stage_times.push_back(now - stage_start);
+      stage_start = now;
+    }
+  };
+
   amrex::MultiFab S_data(
     get_new_data(State_Type).boxArray(),
     get_new_data(State_Type).DistributionMap(), NVAR, 1);
   const amrex::Real cur_time = state[State_Type].curTime();
   FillPatch(
     *this, S_data, S_data.nGrow(), cur_time, State_Type, Density, NVAR, 0);
+  end_stage("FillPatch");
 
-  amrex::Vector<amrex::BCRec> bcs(NVAR);
-  const char tagval = amrex::TagBox::SET;
-  const char clearval = amrex::TagBox::CLEAR;
+  int ftrac_idx = -1;
+  if (!flame_trac_name.empty()) {
+    for (int i = 0; i < spec_names.size(); ++i) {
+      if (flame_trac_name == spec_names[i]) {
+        ftrac_idx = i;
+      }
+    }
+    if (ftrac_idx < 0) {
+      amrex::Abort("Unknown species identified as flame_trac_name");
+    }
+  }
+
+  // Criteria active on this level
+  const bool tag_den = level < TaggingParm::max_denerr_lev ||
+                       level < TaggingParm::max_dengrad_lev;
+  const bool tag_pres = level < TaggingParm::max_presserr_lev ||
+                        level < TaggingParm::max_pressgrad_lev;
+  const bool tag_vel = level < TaggingParm::max_velerr_lev ||
+                       level < TaggingParm::max_velgrad_lev;
+  const bool tag_vort = level < TaggingParm::max_vorterr_lev;
+  const bool tag_temp = level < TaggingParm::max_temperr_lev ||
+                        level < TaggingParm::max_tempgrad_lev;
+  const bool tag_ftrac = ftrac_idx >= 0 &&
+                         (level < TaggingParm::max_ftracerr_lev ||
+                          level < TaggingParm::max_ftracgrad_lev);
+
+  // Components of the derived fields needed by the active criteria. Density
+  // and temperature are tagged directly on the state.
+  int nder = 0;
+  const int pres_comp = tag_pres ? nder++ : -1;
+  const int vel_comp = tag_vel ? nder : -1;
+  nder += tag_vel ? 3 : 0;
+  const int ftrac_comp = tag_ftrac ? nder++ : -1;
+  const int vort_comp = tag_vort ? nder++ : -1;
+
+  amrex::MultiFab S_der;
+  if (nder > 0) {
+    S_der.define(S_data.boxArray(), S_data.DistributionMap(), nder, 1);
 
 #ifdef _OPENMP
 #pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-  {
-    for (amrex::MFIter mfi(S_data, amrex::TilingIfNotGPU()); mfi.isValid();
+    for (amrex::MFIter mfi(S_der, amrex::TilingIfNotGPU()); mfi.isValid();
          ++mfi) {
-      const amrex::Box& tilebox = mfi.tilebox();
-      const auto Sfab = S_data.array(mfi);
-      auto tag_arr = tags.array(mfi);
-      const auto datbox = S_data[mfi].box();
-      amrex::Elixir S_data_mfi_eli = S_data[mfi].elixir();
+      const amrex::Box& gbx = mfi.growntilebox();
+      const auto sarr = S_data.const_array(mfi);
+      auto der = S_der.array(mfi);
 
-#ifdef PELEC_USE_EB
-      const auto vfrac_arr = vfrac.array(mfi);
-#endif
-
-      amrex::FArrayBox S_derData(datbox, 1);
-      amrex::Elixir S_derData_eli = S_derData.elixir();
-      auto S_derarr = S_derData.array();
-      const int ncp = S_derData.nComp();
-      const int* bc = bcs[0].data();
-
-      // Tagging density
-      if (level < TaggingParm::max_denerr_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_error(i, j, k, tag_arr, Sfab, TaggingParm::denerr, tagval);
-          });
-      }
-      if (level < TaggingParm::max_dengrad_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_graderror(i, j, k, tag_arr, Sfab, TaggingParm::dengrad, tagval);
-          });
-      }
-
-      // Tagging pressure
-      S_derData.setVal<amrex::RunOn::Device>(0.0);
-      pc_derpres(
-        datbox, S_derData, ncp, Sfab.nComp(), S_data[mfi], geom, time, bc,
-        level);
-      if (level < TaggingParm::max_presserr_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_error(
-              i, j, k, tag_arr, S_derarr, TaggingParm::presserr, tagval);
-          });
-      }
-      if (level < TaggingParm::max_pressgrad_lev) {
+      // All the pointwise fields in a single pass over the state
+      if (pres_comp >= 0 || vel_comp >= 0 || ftrac_comp >= 0) {
         amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_graderror(
-              i, j, k, tag_arr, S_derarr, TaggingParm::pressgrad, tagval);
+          gbx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+            const amrex::Real rho = sarr(i, j, k, URHO);
+            const amrex::Real rhoInv = 1.0 / rho;
+            if (pres_comp >= 0) {
+              amrex::Real T = sarr(i, j, k, UTEMP);
+              amrex::Real p, massfrac[NUM_SPECIES];
+              for (int n = 0; n < NUM_SPECIES; ++n) {
+                massfrac[n] = sarr(i, j, k, UFS + n) * rhoInv;
+              }
+              EOS::RTY2P(rho, T, massfrac, p);
+              der(i, j, k, pres_comp) = p;
+            }
+            if (vel_comp >= 0) {
+              der(i, j, k, vel_comp) = sarr(i, j, k, UMX) * rhoInv;
+              der(i, j, k, vel_comp + 1) = sarr(i, j, k, UMY) * rhoInv;
+              der(i, j, k, vel_comp + 2) = sarr(i, j, k, UMZ) * rhoInv;
+            }
+            if (ftrac_comp >= 0) {
+              der(i, j, k, ftrac_comp) =
+                sarr(i, j, k, UFS + ftrac_idx) * rhoInv;
+            }
           });
       }
 
-      // Tagging vel_x
-      S_derData.setVal<amrex::RunOn::Device>(0.0);
-      pc_dervelx(
-        datbox, S_derData, ncp, Sfab.nComp(), S_data[mfi], geom, time, bc,
-        level);
-      if (level < TaggingParm::max_velerr_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_error(i, j, k, tag_arr, S_derarr, TaggingParm::velerr, tagval);
-          });
-      }
-      if (level < TaggingParm::max_velgrad_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_graderror(
-              i, j, k, tag_arr, S_derarr, TaggingParm::velgrad, tagval);
-          });
+      if (vort_comp >= 0) {
+        amrex::FArrayBox vort(S_der[mfi], amrex::make_alias, vort_comp, 1);
+        pc_dermagvort(
+          mfi.tilebox(), vort, 0, 1, S_data[mfi], geom, time, nullptr, level);
       }
+    }
+    end_stage("derived fields");
+  }
 
-      // Tagging vel_y
-      S_derData.setVal<amrex::RunOn::Device>(0.0);
-      pc_dervely(
-        datbox, S_derData, ncp, Sfab.nComp(), S_data[mfi], geom, time, bc,
-        level);
-      if (level < TaggingParm::max_velerr_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_error(i, j, k, tag_arr, S_derarr, TaggingParm::velerr, tagval);
-          });
-      }
-      if (level < TaggingParm::max_velgrad_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_graderror(
-              i, j, k, tag_arr, S_derarr, TaggingParm::velgrad, tagval);
-          });
-      }
+  if (tag_den) {
+    pc_tag_field(
+      tags, S_data, URHO, level, TaggingParm::denerr,
+      TaggingParm::max_denerr_lev, TaggingParm::dengrad,
+      TaggingParm::max_dengrad_lev);
+    end_stage("density");
+  }
 
-      // Tagging vel_z
-      S_derData.setVal<amrex::RunOn::Device>(0.0);
-      pc_dervelz(
-        datbox, S_derData, ncp, Sfab.nComp(), S_data[mfi], geom, time, bc,
-        level);
-      if (level < TaggingParm::max_velerr_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_error(i, j, k, tag_arr, S_derarr, TaggingParm::velerr, tagval);
-          });
-      }
-      if (level < TaggingParm::max_velgrad_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_graderror(
-              i, j, k, tag_arr, S_derarr, TaggingParm::velgrad, tagval);
-          });
-      }
+  if (tag_pres) {
+    pc_tag_field(
+      tags, S_der, pres_comp, level, TaggingParm::presserr,
+      TaggingParm::max_presserr_lev, TaggingParm::pressgrad,
+      TaggingParm::max_pressgrad_lev);
+    end_stage("pressure");
+  }
 
-      // Tagging magnitude of vorticity
-      S_derData.setVal<amrex::RunOn::Device>(0.0);
-      pc_dermagvort(
-        tilebox, S_derData, ncp, Sfab.nComp(), S_data[mfi], geom, time, bc,
-        level);
-      if (level < TaggingParm::max_vorterr_lev) {
-        const amrex::Real vorterr = TaggingParm::vorterr * std::pow(2.0, level);
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_abserror(i, j, k, tag_arr, S_derarr, vorterr, tagval);
-          });
-      }
+  if (tag_vel) {
+    for (int n = 0; n < 3; ++n) {
+      pc_tag_field(
+        tags, S_der, vel_comp + n, level, TaggingParm::velerr,
+        TaggingParm::max_velerr_lev, TaggingParm::velgrad,
+        TaggingParm::max_velgrad_lev);
+    }
+    end_stage("velocity");
+  }
 
-      // Tagging temperature
-      S_derData.setVal<amrex::RunOn::Device>(0.0);
-      pc_dertemp(
-        datbox, S_derData, ncp, Sfab.nComp(), S_data[mfi], geom, time, bc,
-        level);
-      if (level < TaggingParm::max_temperr_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_error(i, j, k, tag_arr, S_derarr, TaggingParm::temperr, tagval);
-          });
-      }
-      if (level < TaggingParm::max_tempgrad_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_graderror(
-              i, j, k, tag_arr, S_derarr, TaggingParm::tempgrad, tagval);
-          });
-      }
+  if (tag_vort) {
+    const amrex::Real vorterr = TaggingParm::vorterr * std::pow(2.0, level);
+    pc_tag_field(
+      tags, S_der, vort_comp, level, vorterr, TaggingParm::max_vorterr_lev,
+      0.0, 0, true);
+    end_stage("vorticity");
+  }
 
-      // Tagging flame tracer
-      if (!flame_trac_name.empty()) {
-        int idx = -1;
-        for (int i = 0; i < spec_names.size(); ++i) {
-          if (flame_trac_name == spec_names[i]) {
-            idx = i;
-          }
-        }
+  if (tag_temp) {
+    pc_tag_field(
+      tags, S_data, UTEMP, level, TaggingParm::temperr,
+      TaggingParm::max_temperr_lev, TaggingParm::tempgrad,
+      TaggingParm::max_tempgrad_lev);
+    end_stage("temperature");
+  }
 
-        if (idx >= 0) {
-          // const std::string name = "Y("+flame_trac_name+")";
-          // if (amrex::ParallelDescriptor::IOProcessor())
-          //  amrex::Print() << " Flame tracer will be " << name << '\n';
-
-          S_derData.setVal<amrex::RunOn::Device>(0.0);
-          pc_derspectrac(
-            datbox, S_derData, ncp, Sfab.nComp(), S_data[mfi], geom, time, bc,
-            level, idx);
-
-          if (level < TaggingParm::max_ftracerr_lev) {
-            amrex::ParallelFor(
-              tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tag_error(
-                  i, j, k, tag_arr, S_derarr, TaggingParm::ftracerr, tagval);
-              });
-          }
-          if (level < TaggingParm::max_ftracgrad_lev) {
-            amrex::ParallelFor(
-              tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tag_graderror(
-                  i, j, k, tag_arr, S_derarr, TaggingParm::ftracgrad, tagval);
-              });
-          }
+  if (tag_ftrac) {
+    pc_tag_field(
+      tags, S_der, ftrac_comp, level, TaggingParm::ftracerr,
+      TaggingParm::max_ftracerr_lev, TaggingParm::ftracgrad,
+      TaggingParm::max_ftracgrad_lev);
+    end_stage("flame tracer");
+  }
 
-        } else {
-          amrex::Abort("Unknown species identified as flame_trac_name");
-        }
-      }
+  const char tagval = amrex::TagBox::SET;
 
 #ifdef PELEC_USE_EB
-      // Tagging volume fraction
-      if (level < TaggingParm::max_vfracerr_lev) {
-        amrex::ParallelFor(
-          tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-            tag_error_bounds(i, j, k, tag_arr, vfrac_arr, 0.0, 1.0, tagval);
-          });
-      }
+  // Tagging volume fraction
+  if (level < TaggingParm::max_vfracerr_lev) {
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-
-      // Problem specific tagging
-      const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx =
-        geom.CellSizeArray();
-      const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> prob_lo =
-        geom.ProbLoArray();
-      const auto captured_level = level;
+    for (amrex::MFIter mfi(S_data, amrex::TilingIfNotGPU()); mfi.isValid();
+         ++mfi) {
+      const amrex::Box& tilebox = mfi.tilebox();
+      const auto vfrac_arr = vfrac.array(mfi);
+      auto tag_arr = tags.array(mfi);
       amrex::ParallelFor(
         tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-          set_problem_tags<ProblemTags>(
-            i, j, k, tag_arr, Sfab, tagval, dx, prob_lo, time, captured_level);
+          tag_error_bounds(i, j, k, tag_arr, vfrac_arr, 0.0, 1.0, tagval);
         });
+    }
+    end_stage("volume fraction");
+  }
+#endif
+
+  // Problem specific tagging
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> prob_lo =
+    geom.ProbLoArray();
+  const auto captured_level = level;
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(S_data, amrex::TilingIfNotGPU()); mfi.isValid();
+       ++mfi) {
+    const amrex::Box& tilebox = mfi.tilebox();
+    const auto Sfab = S_data.const_array(mfi);
+    auto tag_arr = tags.array(mfi);
+    amrex::ParallelFor(
+      tilebox, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+        set_problem_tags<ProblemTags>(
+          i, j, k, tag_arr, Sfab, tagval, dx, prob_lo, time, captured_level);
+      });
+  }
+  end_stage("problem");
 
-      // Now update the tags in the TagBox.
-      // tag_arr.tags(itags, tilebox);
-      // rho_eli.clear();
-      // temp_eli.clear();
+  if (verbose) {
+    const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
+    amrex::ParallelDescriptor::ReduceRealMax(
+      stage_times.data(), static_cast<int>(stage_times.size()), IOProc);
+    amrex::Print() << "PeleC::errorEst() at level " << level << " :"
+                   << std::endl;
+    for (int n = 0; n < stage_names.size(); ++n) {
+      amrex::Print() << "  " << stage_names[n]
+                     << " : time = " << stage_times[n] << std::endl;
     }
   }
 }
@@ -1827,6 +1872,10 @@ PeleC::init_reactor()
 #ifdef AMREX_USE_CUDA
   reactor_info(reactor_type, ode_ncells);
 #else
+  if (cvode_ncells < 1) {
+    amrex::Abort("cvode_ncells must be at least 1");
+  }
+  ode_ncells = cvode_ncells;
 #ifdef _OPENMP
 #pragma omp parallel
 #endif
@@ -1863,6 +1912,13 @@ PeleC::init_les()
     LES_Coeffs.setVal(PrT, comp_PrT, 1, LES_Coeffs.nGrow());
   }
 
+  // Filters of the dynamic model, built once per level
+  if (les_model == 1) {
+    les_test_filter = Filter(les_test_filter_type, les_test_filter_fgr);
+    les_coeff_filter = Filter(box, 6);
+  }
+  les_coeff_evals = 0;
+
   amrex::Print() << "WARNING: LES with Fuego assumes Cp is a weak function of T"
                  << std::endl;
   if (NUM_SPECIES > 2) {
@@ -1933,40 +1989,104 @@ PeleC::init_mms()
 #endif
 
 void
-PeleC::reset_internal_energy(amrex::MultiFab& S_new, int ng)
+PeleC::computeTemp(amrex::MultiFab& S, int ng)
 {
 #ifndef AMREX_USE_GPU
   amrex::Real sum = 0.;
   amrex::Real sum0 = 0.;
   if (parent->finestLevel() == 0 && print_energy_diagnostics) {
     // Pass in the multifab and the component
-    sum0 = volWgtSumMF(S_new, Eden, true);
+    sum0 = volWgtSumMF(S, Eden, true);
   }
 #endif
-  // Ensure (rho e) isn't too small or negative
-#ifdef _OPENMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+
+#ifdef PELEC_USE_EB
+  auto const& fact =
+    dynamic_cast<amrex::EBFArrayBoxFactory const&>(S.Factory());
+  auto const& flags = fact.getMultiEBCellFlagFab();
 #endif
+
   const auto captured_allow_small_energy = allow_small_energy;
   const auto captured_allow_negative_energy = allow_negative_energy;
   const auto captured_dual_energy_update_E_from_e = dual_energy_update_E_from_e;
   const auto captured_verbose = verbose;
-  for (amrex::MFIter mfi(S_new, amrex::TilingIfNotGPU()); mfi.isValid();
-       ++mfi) {
+
+  // The temperature updates from the warm start (the stored UTEMP) are only
+  // reduced when they get reported
+  const bool report = verbose > 1;
+  amrex::ReduceOps<amrex::ReduceOpMax, amrex::ReduceOpSum, amrex::ReduceOpSum>
+    reduce_op;
+  amrex::ReduceData<amrex::Real, amrex::Real, long long> reduce_data(
+    reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+
+  // Ensure (rho e) isn't too small or negative, make (rho E) consistent
+  // with it and recover T, all in one pass over the state
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(S, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
     const amrex::Box& bx = mfi.growntilebox(ng);
-    const auto& sarr = S_new.array(mfi);
-    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      pc_rst_int_e(
-        i, j, k, sarr, captured_allow_small_energy,
-        captured_allow_negative_energy, captured_dual_energy_update_E_from_e,
-        captured_verbose);
+    const auto& sarr = S.array(mfi);
+
+    bool covered = false;
+#ifdef PELEC_USE_EB
+    const auto& flag_fab = flags[mfi];
+    covered = flag_fab.getType(bx) == amrex::FabType::covered;
+#endif
+
+    if (report) {
+      reduce_op.eval(
+        bx, reduce_data,
+        [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept -> ReduceTuple {
+          pc_rst_int_e(
+            i, j, k, sarr, captured_allow_small_energy,
+            captured_allow_negative_energy,
+            captured_dual_energy_update_E_from_e, captured_verbose);
+          if (covered) {
+            return {0.0, 0.0, 0};
+          }
+          const amrex::Real dT = pc_cmpTemp(i, j, k, sarr);
+          return {dT, dT, 1};
+        });
+    } else {
+      amrex::ParallelFor(
+        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          pc_rst_int_e(
+            i, j, k, sarr, captured_allow_small_energy,
+            captured_allow_negative_energy,
+            captured_dual_energy_update_E_from_e, captured_verbose);
+          if (!covered) {
+            pc_cmpTemp(i, j, k, sarr);
+          }
+        });
+    }
+  }
+
+  if (report) {
+    ReduceTuple hv = reduce_data.value();
+    amrex::Real dT[2] = {amrex::get<0>(hv), amrex::get<1>(hv)};
+    long long count = amrex::get<2>(hv);
+#ifdef AMREX_LAZY
+    Lazy::QueueReduction([=]() mutable {
+#endif
+      amrex::ParallelDescriptor::ReduceRealMax(dT[0]);
+      amrex::ParallelDescriptor::ReduceRealSum(dT[1]);
+      amrex::ParallelDescriptor::ReduceLongSum(count);
+      if (count > 0) {
+        amrex::Print() << "PeleC::computeTemp() relative temperature update "
+                       << "from the stored temperature: max " << dT[0]
+                       << ", mean " << dT[1] / count << std::endl;
+      }
+#ifdef AMREX_LAZY
     });
+#endif
   }
 
 #ifndef AMREX_USE_GPU
   if (parent->finestLevel() == 0 && print_energy_diagnostics) {
     // Pass in the multifab and the component
-    sum = volWgtSumMF(S_new, Eden, true);
+    sum = volWgtSumMF(S, Eden, true);
 #ifdef AMREX_LAZY
     Lazy::QueueReduction([=]() mutable {
 #endif
@@ -1984,38 +2104,6 @@ PeleC::reset_internal_energy(amrex::MultiFab& S_new, int ng)
 #endif
 }
 
-void
-PeleC::computeTemp(amrex::MultiFab& S, int ng)
-{
-  reset_internal_energy(S, ng);
-
-#ifdef PELEC_USE_EB
-  auto const& fact =
-    dynamic_cast<amrex::EBFArrayBoxFactory const&>(S.Factory());
-  auto const& flags = fact.getMultiEBCellFlagFab();
-#endif
-
-#ifdef _OPENMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
-#endif
-  for (amrex::MFIter mfi(S, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi) {
-    const amrex::Box& bx = mfi.growntilebox(ng);
-
-#ifdef PELEC_USE_EB
-    const auto& flag_fab = flags[mfi];
-    amrex::FabType typ = flag_fab.getType(bx);
-    if (typ == amrex::FabType::covered) {
-      continue;
-    }
-#endif
-
-    const auto& sarr = S.array(mfi);
-    amrex::ParallelFor(bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-      pc_cmpTemp(i, j, k, sarr);
-    });
-  }
-}
-
 amrex::Real
 PeleC::getCPUTime()
 {
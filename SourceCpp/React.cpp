@@ -1,3 +1,9 @@
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <algorithm>
+
 #include <AMReX_DistributionMapping.H>
 
 #include "PeleC.H"
@@ -74,267 +80,117 @@ PeleC::react_state(
   react_src.setVal(0.0);
   prefetchToDevice(react_src);
 
-#ifdef PELEC_USE_EB
-  auto const& fact =
-    dynamic_cast<amrex::EBFArrayBoxFactory const&>(S_new.Factory());
-  auto const& flags = fact.getMultiEBCellFlagFab();
-#endif
+  // Window outside of which the chemistry is considered inactive
+  const amrex::Real T_min = react_T_min;
+  const amrex::Real T_max = react_T_max;
+  const amrex::Real rho_min = react_rho_min;
+  const amrex::Real rho_max = react_rho_max;
+
+  if (verbose > 1) {
+    const amrex::MultiFab& S_react =
+      react_init ? S_new : get_old_data(State_Type);
+    amrex::Real nactive = amrex::ReduceSum(
+      S_react, 0,
+      [=] AMREX_GPU_HOST_DEVICE(
+        amrex::Box const& bx,
+        const amrex::Array4<const amrex::Real>& s) noexcept -> amrex::Real {
+        amrex::Real r = 0.0;
+        amrex::Loop(bx, [=, &r](int i, int j, int k) noexcept {
+          if (pc_react_active(i, j, k, s, T_min, T_max, rho_min, rho_max)) {
+            r += 1.0;
+          }
+        });
+        return r;
+      });
+    amrex::ParallelDescriptor::ReduceRealSum(nactive);
+    amrex::Print() << "... Reacting cells: "
+                   << 100.0 * nactive / grids.d_numPts() << "%" << std::endl;
+  }
 
 #ifdef _OPENMP
-#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+  const int nthreads = omp_get_max_threads();
+#else
+  const int nthreads = 1;
 #endif
-  {
-    for (amrex::MFIter mfi(S_new, amrex::TilingIfNotGPU()); mfi.isValid();
-         ++mfi) {
 
-      const amrex::Box& bx = mfi.growntilebox(ng);
-      const amrex::Box vbox = mfi.tilebox();
-
-      // old state or the state at t=0
-      auto const& sold_arr =
-        react_init ? S_new.array(mfi) : get_old_data(State_Type).array(mfi);
+#ifndef AMREX_USE_CUDA
+  if (chem_integrator == 2) {
+    if (react_buffers.size() < nthreads) {
+      react_buffers.resize(nthreads);
+    }
+  }
+#endif
 
-      // new state
-      auto const& snew_arr = S_new.array(mfi);
-      auto const& nonrs_arr = non_react_src->array(mfi);
-      auto const& I_R = react_src.array(mfi);
+  // Time spent integrating the chemistry by each thread, used to report
+  // the load imbalance between threads
+  amrex::Vector<amrex::Real> thread_time(nthreads, 0.0);
 
-      // only update beyond first step
-      // TODO: Update here? Or just get reaction source?
-      const int do_update = react_init ? 0 : 1;
+  if (react_work_queue && amrex::Gpu::notInLaunchRegion()) {
+    // Per-cell cost of the chemistry measured at the previous call,
+    // uniform until it has been measured once
+    if (!react_cost.ok()) {
+      react_cost.define(grids, dmap, 1, ng);
+      react_cost.setVal(1.0);
+    }
 
-      amrex::Real wt =
-        amrex::ParallelDescriptor::second(); // timing for each fab
-#ifdef PELEC_USE_EB
-      const auto& flag_fab = flags[mfi];
-      amrex::FabType typ = flag_fab.getType(bx);
-      if (typ == amrex::FabType::covered) {
-        if (do_react_load_balance) {
-          wt = 0.0;
-          get_new_data(Work_Estimate_Type)[mfi].plus<amrex::RunOn::Device>(
-            wt, vbox);
-        }
-        continue;
-      } else if (
-        typ == amrex::FabType::singlevalued || typ == amrex::FabType::regular)
-#endif
-      {
-        if (chem_integrator == 1) {
-
-          // for rk64 we set minimum, maximum and guess
-          // number of sub-iterations
-          const int nsubsteps_min = adaptrk_nsubsteps_min;
-          const int nsubsteps_max = adaptrk_nsubsteps_max;
-          const int nsubsteps_guess = adaptrk_nsubsteps_guess;
-
-          // for rk64 we set the error tolerance
-          const amrex::Real errtol = adaptrk_errtol;
-
-          amrex::ParallelFor(
-            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-              pc_expl_reactions(
-                i, j, k, sold_arr, snew_arr, nonrs_arr, I_R, dt, nsubsteps_min,
-                nsubsteps_max, nsubsteps_guess, errtol, do_update);
-            });
-        } else if (chem_integrator == 2) {
-#ifdef USE_SUNDIALS_PP
-          const auto len = amrex::length(bx);
-          const auto lo = amrex::lbound(bx);
-          const int ncells = len.x * len.y * len.z;
-          int reactor_type = 1;
-          amrex::Real chemintg_cost;
-          amrex::Real current_time = 0.0;
-
-          amrex::Real* rY_in;
-          amrex::Real* rY_src_in;
-          amrex::Real* re_in;
-          amrex::Real* re_src_in;
+    struct ReactWorkItem
+    {
+      int K;
+      amrex::Box bx;
+      amrex::Box vbox;
+      amrex::Real cost;
+    };
 
-#ifdef AMREX_USE_CUDA
-          cudaError_t cuda_status = cudaSuccess;
-          cudaMallocManaged(
-            &rY_in, (NUM_SPECIES + 1) * ncells * sizeof(amrex::Real));
-          cudaMallocManaged(
-            &rY_src_in, NUM_SPECIES * ncells * sizeof(amrex::Real));
-          cudaMallocManaged(&re_in, ncells * sizeof(amrex::Real));
-          cudaMallocManaged(&re_src_in, ncells * sizeof(amrex::Real));
-
-          int ode_ncells = ncells;
-#else
-          rY_in = new amrex::Real[ncells * (NUM_SPECIES + 1)];
-          rY_src_in = new amrex::Real[ncells * (NUM_SPECIES)];
-          re_in = new amrex::Real[ncells];
-          re_src_in = new amrex::Real[ncells];
+    amrex::Vector<ReactWorkItem> work;
+    for (amrex::MFIter mfi(S_new, true); mfi.isValid(); ++mfi) {
+      const amrex::Box& bx = mfi.growntilebox(ng);
+      work.push_back(
+        {mfi.index(), bx, mfi.tilebox(),
+         react_cost[mfi].sum<amrex::RunOn::Host>(bx, 0)});
+    }
 
-          int ode_ncells = 1;
-#endif
-          amrex::ParallelFor(
-            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-              // work on old state
-              amrex::Real rhou = sold_arr(i, j, k, UMX);
-              amrex::Real rhov = sold_arr(i, j, k, UMY);
-              amrex::Real rhow = sold_arr(i, j, k, UMZ);
-              amrex::Real rho_old = sold_arr(i, j, k, URHO);
-              amrex::Real rhoInv = 1.0 / rho_old;
-
-              amrex::Real e_old =
-                (sold_arr(i, j, k, UEDEN) // total energy
-                 -
-                 0.5 * (rhou * rhou + rhov * rhov + rhow * rhow) * rhoInv) // KE
-                * rhoInv;
-
-              // work on new state
-              rhou = snew_arr(i, j, k, UMX);
-              rhov = snew_arr(i, j, k, UMY);
-              rhow = snew_arr(i, j, k, UMZ);
-              rhoInv = 1.0 / snew_arr(i, j, k, URHO);
-
-              amrex::Real rhoedot_ext =
-                (snew_arr(i, j, k, UEDEN) // new total energy
-                 - 0.5 * (rhou * rhou + rhov * rhov + rhow * rhow) *
-                     rhoInv // new KE
-                 - rho_old * e_old) /
-                dt;
-
-              int offset =
-                (k - lo.z) * len.x * len.y + (j - lo.y) * len.x + (i - lo.x);
-              for (int nsp = 0; nsp < NUM_SPECIES; nsp++) {
-                rY_in[offset * (NUM_SPECIES + 1) + nsp] =
-                  sold_arr(i, j, k, UFS + nsp);
-                rY_src_in[offset * NUM_SPECIES + nsp] =
-                  nonrs_arr(i, j, k, UFS + nsp);
-              }
-              rY_in[offset * (NUM_SPECIES + 1) + NUM_SPECIES] =
-                sold_arr(i, j, k, UTEMP);
-              re_in[offset] = rho_old * e_old;
-              re_src_in[offset] = rhoedot_ext;
-            });
+    // Hand out the most expensive tiles first so that the cheap ones fill
+    // in the gaps left at the end
+    std::sort(
+      work.begin(), work.end(),
+      [](const ReactWorkItem& a, const ReactWorkItem& b) {
+        return a.cost > b.cost;
+      });
 
-#ifdef AMREX_USE_CUDA
-          cuda_status = cudaStreamSynchronize(amrex::Gpu::gpuStream());
+    const int nwork = work.size();
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
 #endif
-          chemintg_cost = 0.0;
-          for (int i = 0; i < ncells; i += ode_ncells) {
-
-#ifdef AMREX_USE_CUDA
-            chemintg_cost += react(
-              rY_in + i * (NUM_SPECIES + 1), rY_src_in + i * NUM_SPECIES,
-              re_in + i, re_src_in + i, &dt, &current_time, reactor_type,
-              ode_ncells, amrex::Gpu::gpuStream());
+    for (int n = 0; n < nwork; n++) {
+      const ReactWorkItem& w = work[n];
+      const amrex::Real tile_time =
+        react_state_tile(w.K, w.bx, w.vbox, dt, react_init, *non_react_src);
+      react_cost[w.K].setVal<amrex::RunOn::Host>(
+        tile_time / w.bx.d_numPts(), w.bx);
+#ifdef _OPENMP
+      thread_time[omp_get_thread_num()] += tile_time;
 #else
-            chemintg_cost += react(
-              rY_in + i * (NUM_SPECIES + 1), rY_src_in + i * NUM_SPECIES,
-              re_in + i, re_src_in + i, dt, current_time);
+      thread_time[0] += tile_time;
 #endif
-          }
-          chemintg_cost = chemintg_cost / ncells;
-
-          // unpack data
-          amrex::ParallelFor(
-            bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-              // work on old state
-              amrex::Real rhou = sold_arr(i, j, k, UMX);
-              amrex::Real rhov = sold_arr(i, j, k, UMY);
-              amrex::Real rhow = sold_arr(i, j, k, UMZ);
-              amrex::Real rho_old = sold_arr(i, j, k, URHO);
-              amrex::Real rhoInv = 1.0 / rho_old;
-
-              amrex::Real e_old =
-                (sold_arr(i, j, k, UEDEN) // old total energy
-                 -
-                 0.5 * (rhou * rhou + rhov * rhov + rhow * rhow) * rhoInv) // KE
-                * rhoInv;
-
-              rhou = snew_arr(i, j, k, UMX);
-              rhov = snew_arr(i, j, k, UMY);
-              rhow = snew_arr(i, j, k, UMZ);
-              rhoInv = 1.0 / snew_arr(i, j, k, URHO);
-
-              amrex::Real rhoedot_ext =
-                (snew_arr(i, j, k, UEDEN) // new total energy
-                 -
-                 0.5 * (rhou * rhou + rhov * rhov + rhow * rhow) * rhoInv // KE
-                 - rho_old * e_old) // old internal energy
-                / dt;
-
-              amrex::Real umnew =
-                sold_arr(i, j, k, UMX) + dt * nonrs_arr(i, j, k, UMX);
-              amrex::Real vmnew =
-                sold_arr(i, j, k, UMY) + dt * nonrs_arr(i, j, k, UMY);
-              amrex::Real wmnew =
-                sold_arr(i, j, k, UMZ) + dt * nonrs_arr(i, j, k, UMZ);
-
-              // get new rho
-              amrex::Real rhonew = 0.;
-              int offset =
-                (k - lo.z) * len.x * len.y + (j - lo.y) * len.x + (i - lo.x);
-              for (int nsp = 0; nsp < NUM_SPECIES; nsp++) {
-                rhonew += rY_in[offset * (NUM_SPECIES + 1) + nsp];
-              }
-
-              if (do_update) {
-                snew_arr(i, j, k, URHO) = rhonew;
-                snew_arr(i, j, k, UMX) = umnew;
-                snew_arr(i, j, k, UMY) = vmnew;
-                snew_arr(i, j, k, UMZ) = wmnew;
-                for (int nsp = 0; nsp < NUM_SPECIES; nsp++) {
-                  snew_arr(i, j, k, UFS + nsp) =
-                    rY_in[offset * (NUM_SPECIES + 1) + nsp];
-                }
-                snew_arr(i, j, k, UTEMP) =
-                  rY_in[offset * (NUM_SPECIES + 1) + NUM_SPECIES];
-
-                snew_arr(i, j, k, UEINT) = rho_old * e_old + dt * rhoedot_ext;
-                snew_arr(i, j, k, UEDEN) =
-                  snew_arr(i, j, k, UEINT) +
-                  0.5 * (umnew * umnew + vmnew * vmnew + wmnew * wmnew) /
-                    rhonew;
-              }
-
-              for (int nsp = 0; nsp < NUM_SPECIES; nsp++) {
-                I_R(i, j, k, nsp) =
-                  (rY_in[offset * (NUM_SPECIES + 1) + nsp] // new rhoy
-                   - sold_arr(i, j, k, UFS + nsp))         // old rhoy
-                    / dt -
-                  nonrs_arr(i, j, k, UFS + nsp);
-              }
-              I_R(i, j, k, NUM_SPECIES) =
-                (rho_old * e_old + dt * rhoedot_ext // new internal energy
-                 + 0.5 * (umnew * umnew + vmnew * vmnew + wmnew * wmnew) /
-                     rhonew                  // new KE
-                 - sold_arr(i, j, k, UEDEN)) // old total energy
-                  / dt -
-                nonrs_arr(i, j, k, UEDEN);
-            });
-
-#ifdef AMREX_USE_CUDA
-          cudaFree(rY_in);
-          cudaFree(rY_src_in);
-          cudaFree(re_in);
-          cudaFree(re_src_in);
-#else
-          delete[] rY_in;
-          delete[] rY_src_in;
-          delete[] re_in;
-          delete[] re_src_in;
+    }
+  } else {
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
 #endif
-          wt = (amrex::ParallelDescriptor::second() - wt) / bx.d_numPts();
-
-          if (do_react_load_balance) {
-            get_new_data(Work_Estimate_Type)[mfi].plus<amrex::RunOn::Device>(
-              wt, vbox);
-          }
+    for (amrex::MFIter mfi(S_new, amrex::TilingIfNotGPU()); mfi.isValid();
+         ++mfi) {
+      const amrex::Real tile_time = react_state_tile(
+        mfi.index(), mfi.growntilebox(ng), mfi.tilebox(), dt, react_init,
+        *non_react_src);
+#ifdef _OPENMP
+      thread_time[omp_get_thread_num()] += tile_time;
 #else
-          amrex::Abort(
-            "chem_integrator=2 which requires Sundials to be enabled");
+      thread_time[0] += tile_time;
 #endif
-        } else {
-          amrex::Abort("chem_integrator must be equal to 1 or 2");
-        }
-      }
     }
   }
 
+
   if (ng > 0)
     S_new.FillBoundary(geom.periodicity());
 
@@ -343,15 +199,264 @@ PeleC::react_state(
     const int IOProc = amrex::ParallelDescriptor::IOProcessorNumber();
     amrex::Real run_time = amrex::ParallelDescriptor::second() - strt_time;
 
+    // Ratio of the busiest thread to the average thread
+    amrex::Real max_time = 0.0;
+    amrex::Real sum_time = 0.0;
+    for (int n = 0; n < nthreads; n++) {
+      max_time = amrex::max(max_time, thread_time[n]);
+      sum_time += thread_time[n];
+    }
+    amrex::Real imbalance =
+      sum_time > 0.0 ? max_time * nthreads / sum_time : 1.0;
+
 #ifdef AMREX_LAZY
     Lazy::QueueReduction([=]() mutable {
 #endif
       amrex::ParallelDescriptor::ReduceRealMax(run_time, IOProc);
+      amrex::ParallelDescriptor::ReduceRealMax(imbalance, IOProc);
 
-      if (amrex::ParallelDescriptor::IOProcessor())
+      if (amrex::ParallelDescriptor::IOProcessor()) {
         amrex::Print() << "PeleC::react_state() time = " << run_time << "\n";
+        amrex::Print() << "PeleC::react_state() thread imbalance (max/mean) = "
+                       << imbalance << "\n";
+      }
 #ifdef AMREX_LAZY
     });
 #endif
   }
 }
+
+amrex::Real
+PeleC::react_state_tile(
+  const int K,
+  const amrex::Box& bx,
+  const amrex::Box& vbox,
+  amrex::Real dt,
+  bool react_init,
+  const amrex::MultiFab& non_react_src)
+{
+  /*
+    Integrate the chemistry over the (grown) tile bx of fab K and return
+    the time spent doing so
+   */
+  const amrex::Real tile_strt_time = amrex::ParallelDescriptor::second();
+
+  amrex::MultiFab& S_new = get_new_data(State_Type);
+  amrex::MultiFab& react_src = get_new_data(Reactions_Type);
+
+  // Window outside of which the chemistry is considered inactive
+  const amrex::Real T_min = react_T_min;
+  const amrex::Real T_max = react_T_max;
+  const amrex::Real rho_min = react_rho_min;
+  const amrex::Real rho_max = react_rho_max;
+
+#ifdef PELEC_USE_EB
+  auto const& fact =
+    dynamic_cast<amrex::EBFArrayBoxFactory const&>(S_new.Factory());
+  auto const& flags = fact.getMultiEBCellFlagFab();
+#endif
+
+  // old state or the state at t=0
+  auto const& sold_arr =
+    react_init ? S_new.array(K) : get_old_data(State_Type).array(K);
+
+  // new state
+  auto const& snew_arr = S_new.array(K);
+  auto const& nonrs_arr = non_react_src.array(K);
+  auto const& I_R = react_src.array(K);
+
+  // only update beyond first step
+  // TODO: Update here? Or just get reaction source?
+  const int do_update = react_init ? 0 : 1;
+
+  amrex::Real wt = amrex::ParallelDescriptor::second(); // timing for each fab
+#ifdef PELEC_USE_EB
+  const auto& flag_fab = flags[K];
+  amrex::FabType typ = flag_fab.getType(bx);
+  if (typ == amrex::FabType::covered) {
+    if (do_react_load_balance) {
+      wt = 0.0;
+      get_new_data(Work_Estimate_Type)[K].plus<amrex::RunOn::Device>(wt, vbox);
+    }
+    return 0.0;
+  } else if (
+    typ == amrex::FabType::singlevalued || typ == amrex::FabType::regular)
+#endif
+  {
+    if (chem_integrator == 1) {
+
+      // for rk64 we set minimum, maximum and guess
+      // number of sub-iterations
+      const int nsubsteps_min = adaptrk_nsubsteps_min;
+      const int nsubsteps_max = adaptrk_nsubsteps_max;
+      const int nsubsteps_guess = adaptrk_nsubsteps_guess;
+
+      // for rk64 we set the error tolerance
+      const amrex::Real errtol = adaptrk_errtol;
+
+      // Inactive cells keep the non-reacting update already in S_new
+      // and a zero I_R
+      amrex::ParallelFor(
+        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          if (pc_react_active(
+                i, j, k, sold_arr, T_min, T_max, rho_min, rho_max)) {
+            pc_expl_reactions(
+              i, j, k, sold_arr, snew_arr, nonrs_arr, I_R, dt,
+              nsubsteps_min, nsubsteps_max, nsubsteps_guess, errtol,
+              do_update);
+          }
+        });
+    } else if (chem_integrator == 2) {
+#ifdef USE_SUNDIALS_PP
+      const auto len = amrex::length(bx);
+      const auto lo = amrex::lbound(bx);
+      int reactor_type = 1;
+      amrex::Real chemintg_cost;
+      amrex::Real current_time = 0.0;
+
+      amrex::Real* rY_in;
+      amrex::Real* rY_src_in;
+      amrex::Real* re_in;
+      amrex::Real* re_src_in;
+
+#ifdef AMREX_USE_CUDA
+      // The whole tile is integrated as one batch on the GPU, inactive
+      // cells are simply not unpacked
+      const int ncells = len.x * len.y * len.z;
+
+      cudaError_t cuda_status = cudaSuccess;
+      cudaMallocManaged(
+        &rY_in, (NUM_SPECIES + 1) * ncells * sizeof(amrex::Real));
+      cudaMallocManaged(
+        &rY_src_in, NUM_SPECIES * ncells * sizeof(amrex::Real));
+      cudaMallocManaged(&re_in, ncells * sizeof(amrex::Real));
+      cudaMallocManaged(&re_src_in, ncells * sizeof(amrex::Real));
+
+      int ode_ncells = ncells;
+
+      amrex::ParallelFor(
+        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          const int offset =
+            (k - lo.z) * len.x * len.y + (j - lo.y) * len.x + (i - lo.x);
+          pc_cvode_pack(
+            i, j, k, offset, sold_arr, snew_arr, nonrs_arr, rY_in,
+            rY_src_in, re_in, re_src_in, dt);
+        });
+
+      cuda_status = cudaStreamSynchronize(amrex::Gpu::gpuStream());
+#else
+#ifdef _OPENMP
+      auto& rbuf = react_buffers[omp_get_thread_num()];
+#else
+      auto& rbuf = react_buffers[0];
+#endif
+      // Compact the active cells of the tile into a list
+      auto& cells = rbuf.cells;
+      cells.clear();
+      amrex::LoopOnCpu(bx, [&](int i, int j, int k) noexcept {
+        if (pc_react_active(
+              i, j, k, sold_arr, T_min, T_max, rho_min, rho_max)) {
+          cells.push_back(
+            (k - lo.z) * len.x * len.y + (j - lo.y) * len.x + (i - lo.x));
+        }
+      });
+      const int ncells = cells.size();
+
+      // Cells are integrated in batches of cvode_ncells, so pad the
+      // packed arrays to a whole number of batches
+      const int ode_ncells = cvode_ncells;
+      const int ncells_pad =
+        ((ncells + ode_ncells - 1) / ode_ncells) * ode_ncells;
+
+      rbuf.resize(ncells_pad);
+      rY_in = rbuf.rY.data();
+      rY_src_in = rbuf.rY_src.data();
+      re_in = rbuf.re.data();
+      re_src_in = rbuf.re_src.data();
+
+      for (int n = 0; n < ncells; n++) {
+        const int i = lo.x + cells[n] % len.x;
+        const int j = lo.y + (cells[n] / len.x) % len.y;
+        const int k = lo.z + cells[n] / (len.x * len.y);
+        pc_cvode_pack(
+          i, j, k, n, sold_arr, snew_arr, nonrs_arr, rY_in, rY_src_in,
+          re_in, re_src_in, dt);
+      }
+
+      // Padding cells repeat the last active cell of the tile; their
+      // result is never unpacked
+      for (int n = ncells; n < ncells_pad; n++) {
+        for (int nsp = 0; nsp < NUM_SPECIES + 1; nsp++) {
+          rY_in[n * (NUM_SPECIES + 1) + nsp] =
+            rY_in[(ncells - 1) * (NUM_SPECIES + 1) + nsp];
+        }
+        for (int nsp = 0; nsp < NUM_SPECIES; nsp++) {
+          rY_src_in[n * NUM_SPECIES + nsp] =
+            rY_src_in[(ncells - 1) * NUM_SPECIES + nsp];
+        }
+        re_in[n] = re_in[ncells - 1];
+        re_src_in[n] = re_src_in[ncells - 1];
+      }
+#endif
+      chemintg_cost = 0.0;
+      for (int i = 0; i < ncells; i += ode_ncells) {
+
+#ifdef AMREX_USE_CUDA
+        chemintg_cost += react(
+          rY_in + i * (NUM_SPECIES + 1), rY_src_in + i * NUM_SPECIES,
+          re_in + i, re_src_in + i, &dt, &current_time, reactor_type,
+          ode_ncells, amrex::Gpu::gpuStream());
+#else
+        chemintg_cost += react(
+          rY_in + i * (NUM_SPECIES + 1), rY_src_in + i * NUM_SPECIES,
+          re_in + i, re_src_in + i, dt, current_time);
+#endif
+      }
+      if (ncells > 0) {
+        chemintg_cost = chemintg_cost / ncells;
+      }
+
+      // unpack data
+#ifdef AMREX_USE_CUDA
+      amrex::ParallelFor(
+        bx, [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+          if (pc_react_active(
+                i, j, k, sold_arr, T_min, T_max, rho_min, rho_max)) {
+            const int offset =
+              (k - lo.z) * len.x * len.y + (j - lo.y) * len.x + (i - lo.x);
+            pc_cvode_unpack(
+              i, j, k, offset, sold_arr, snew_arr, nonrs_arr, I_R, rY_in,
+              dt, do_update);
+          }
+        });
+
+      cudaFree(rY_in);
+      cudaFree(rY_src_in);
+      cudaFree(re_in);
+      cudaFree(re_src_in);
+#else
+      for (int n = 0; n < ncells; n++) {
+        const int i = lo.x + cells[n] % len.x;
+        const int j = lo.y + (cells[n] / len.x) % len.y;
+        const int k = lo.z + cells[n] / (len.x * len.y);
+        pc_cvode_unpack(
+          i, j, k, n, sold_arr, snew_arr, nonrs_arr, I_R, rY_in, dt,
+          do_update);
+      }
+#endif
+      wt = (amrex::ParallelDescriptor::second() - wt) / bx.d_numPts();
+
+      if (do_react_load_balance) {
+        get_new_data(Work_Estimate_Type)[K].plus<amrex::RunOn::Device>(
+          wt, vbox);
+      }
+#else
+      amrex::Abort("chem_integrator=2 which requires Sundials to be enabled");
+#endif
+    } else {
+      amrex::Abort("chem_integrator must be equal to 1 or 2");
+    }
+  }
+
+  return amrex::ParallelDescriptor::second() - tile_strt_time;
+}
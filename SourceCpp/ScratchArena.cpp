@@ -0,0 +1,82 @@
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_Print.H>
+
+#include "ScratchArena.H"
+
+std::atomic<long long> ScratchArena::s_bytes_reused{0};
+std::atomic<long long> ScratchArena::s_bytes_allocated{0};
+
+namespace {
+// Keep the scratch fabs 64-byte aligned relative to the chunk
+constexpr std::size_t scratch_align = 64 / sizeof(amrex::Real);
+} // namespace
+
+ScratchArena&
+ScratchArena::get()
+{
+  thread_local ScratchArena arena;
+  return arena;
+}
+
+amrex::FArrayBox
+ScratchArena::fab(const amrex::Box& bx, const int ncomp)
+{
+#ifdef AMREX_USE_GPU
+  return amrex::FArrayBox(bx, ncomp);
+#else
+  const std::size_t n = bx.numPts() * ncomp;
+  return amrex::FArrayBox(bx, ncomp, alloc(n));
+#endif
+}
+
+amrex::Real*
+ScratchArena::alloc(std::size_t n)
+{
+  n = (n + scratch_align - 1) / scratch_align * scratch_align;
+  const long long bytes = n * sizeof(amrex::Real);
+
+  if (m_used + n > m_main.size) {
+    // Does not fit: serve it from its own overflow chunk for this tile
+    Chunk c;
+    c.data.reset(new amrex::Real[n]);
+    c.size = n;
+    m_overflow.push_back(std::move(c));
+    m_overflow_size += n;
+    s_bytes_allocated += bytes;
+    return m_overflow.back().data.get();
+  }
+
+  amrex::Real* p = m_main.data.get() + m_used;
+  m_used += n;
+  s_bytes_reused += bytes;
+  return p;
+}
+
+void
+ScratchArena::reset()
+{
+  if (!m_overflow.empty()) {
+    // Merge into a single chunk large enough for this whole tile
+    const std::size_t n = m_used + m_overflow_size;
+    m_overflow.clear();
+    m_main.data.reset(new amrex::Real[n]);
+    m_main.size = n;
+    s_bytes_allocated += n * sizeof(amrex::Real);
+  }
+  m_used = 0;
+  m_overflow_size = 0;
+}
+
+void
+ScratchArena::print_stats()
+{
+  long long stats[2] = {s_bytes_reused, s_bytes_allocated};
+  amrex::ParallelDescriptor::ReduceLongSum(stats, 2);
+  const double total = static_cast<double>(stats[0] + stats[1]);
+  amrex::Print() << "Scratch arena: " << stats[0] << " bytes reused, "
+                 << stats[1] << " bytes allocated";
+  if (total > 0.0) {
+    amrex::Print() << " (" << 100.0 * stats[0] / total << "% reused)";
+  }
+  amrex::Print() << std::endl;
+}
@@ -10,8 +10,6 @@ PeleC::sum_integrated_quantities()
   if (verbose <= 0)
     return;
 
-  bool local_flag = true;
-
   int finest_level = parent->finestLevel();
   amrex::Real time = state[State_Type].curTime();
   amrex::Real mass = 0.0;
@@ -25,24 +23,24 @@ PeleC::sum_integrated_quantities()
   int datwidth = 14;
   int datprecision = 6;
 
+  amrex::Real sums[NUM_IQ] = {0.0};
   for (int lev = 0; lev <= finest_level; lev++) {
-    PeleC& pc_lev = getLevel(lev);
-
-    mass += pc_lev.volWgtSum("density", time, local_flag);
-    mom[0] += pc_lev.volWgtSum("xmom", time, local_flag);
-    mom[1] += pc_lev.volWgtSum("ymom", time, local_flag);
-    mom[2] += pc_lev.volWgtSum("zmom", time, local_flag);
-    rho_e += pc_lev.volWgtSum("rho_e", time, local_flag);
-    rho_K += pc_lev.volWgtSum("kineng", time, local_flag);
-    rho_E += pc_lev.volWgtSum("rho_E", time, local_flag);
-    enstr += pc_lev.volWgtSum("enstrophy", time, local_flag);
-
-    if (fuel_name != "") {
-      fuel_prod += pc_lev.volWgtSum("rho_omega_" + fuel_name, time, local_flag);
+    amrex::Real lev_sums[NUM_IQ];
+    getLevel(lev).volWgtSumIQ(time, lev_sums);
+    for (int n = 0; n < NUM_IQ; ++n) {
+      sums[n] += lev_sums[n];
     }
-
-    temp += pc_lev.volWgtSum("Temp", time, local_flag);
   }
+  mass = sums[iq_mass];
+  mom[0] = sums[iq_xmom];
+  mom[1] = sums[iq_ymom];
+  mom[2] = sums[iq_zmom];
+  rho_e = sums[iq_rho_e];
+  rho_K = sums[iq_rho_K];
+  rho_E = sums[iq_rho_E];
+  enstr = sums[iq_enstrophy];
+  fuel_prod = sums[iq_fuel_prod];
+  temp = sums[iq_temp];
 
   if (verbose > 0) {
     const int nfoo = 10;
@@ -136,3 +134,112 @@ PeleC::sum_integrated_quantities()
 #endif
   }
 }
+
+void
+PeleC::volWgtSumIQ(amrex::Real time, amrex::Real* sums)
+{
+  BL_PROFILE("PeleC::volWgtSumIQ()");
+
+  if (sum_iq_state.empty()) {
+    sum_iq_state.define(grids, dmap, NVAR, 1, amrex::MFInfo(), Factory());
+  }
+  FillPatch(*this, sum_iq_state, 1, time, State_Type, 0, NVAR);
+
+  const bool use_mask = level < parent->finestLevel();
+  const amrex::MultiFab* fmask =
+    use_mask ? &getLevel(level + 1).build_fine_mask() : nullptr;
+
+  int fuel_comp = -1;
+#ifdef PELEC_USE_REACTIONS
+  if (!fuel_name.empty()) {
+    for (int n = 0; n < spec_names.size(); ++n) {
+      if (spec_names[n] == fuel_name) {
+        fuel_comp = n;
+      }
+    }
+    if (fuel_comp < 0) {
+      amrex::Abort("PeleC::volWgtSumIQ: unknown fuel_name " + fuel_name);
+    }
+  }
+  const amrex::MultiFab& R = get_data(Reactions_Type, time);
+#endif
+  const bool have_fuel = fuel_comp >= 0;
+
+  const amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dx = geom.CellSizeArray();
+
+  amrex::ReduceOps<
+    amrex::ReduceOpSum, amrex::ReduceOpSum, amrex::ReduceOpSum,
+    amrex::ReduceOpSum, amrex::ReduceOpSum, amrex::ReduceOpSum,
+    amrex::ReduceOpSum, amrex::ReduceOpSum, amrex::ReduceOpSum,
+    amrex::ReduceOpSum>
+    reduce_op;
+  amrex::ReduceData<
+    amrex::Real, amrex::Real, amrex::Real, amrex::Real, amrex::Real,
+    amrex::Real, amrex::Real, amrex::Real, amrex::Real, amrex::Real>
+    reduce_data(reduce_op);
+  using ReduceTuple = typename decltype(reduce_data)::Type;
+  static_assert(
+    amrex::GpuTupleSize<ReduceTuple>::value == NUM_IQ,
+    "one reduction per integrand of SumIQ.H");
+
+#ifdef _OPENMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+  for (amrex::MFIter mfi(sum_iq_state, amrex::TilingIfNotGPU()); mfi.isValid();
+       ++mfi) {
+    const amrex::Box bx = mfi.tilebox();
+    auto const& s = sum_iq_state.const_array(mfi);
+    auto const& vol = volume.const_array(mfi);
+    auto const& mask =
+      use_mask ? fmask->const_array(mfi) : amrex::Array4<const amrex::Real>{};
+#ifdef PELEC_USE_EB
+    auto const& vf = vfrac.const_array(mfi);
+#endif
+#ifdef PELEC_USE_REACTIONS
+    auto const& r = R.const_array(mfi);
+#else
+    auto const& r = amrex::Array4<const amrex::Real>{};
+#endif
+    reduce_op.eval(
+      bx, reduce_data,
+      [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept -> ReduceTuple {
+        amrex::Real w = vol(i, j, k);
+        if (use_mask) {
+          w *= mask(i, j, k);
+        }
+#ifdef PELEC_USE_EB
+        w *= vf(i, j, k);
+#endif
+        const amrex::Real rho = s(i, j, k, URHO);
+        const amrex::Real rho_K =
+          0.5 / rho *
+          (s(i, j, k, UMX) * s(i, j, k, UMX) +
+           s(i, j, k, UMY) * s(i, j, k, UMY) +
+           s(i, j, k, UMZ) * s(i, j, k, UMZ));
+        const amrex::Real enstr = pc_iq_enstrophy(i, j, k, s, dx);
+        const amrex::Real fuel_prod = have_fuel ? r(i, j, k, fuel_comp) : 0.0;
+        return {w * rho,
+                w * s(i, j, k, UMX),
+                w * s(i, j, k, UMY),
+                w * s(i, j, k, UMZ),
+                w * s(i, j, k, UEINT),
+                w * rho_K,
+                w * s(i, j, k, UEDEN),
+                w * enstr,
+                w * fuel_prod,
+                w * s(i, j, k, UTEMP)};
+      });
+  }
+
+  ReduceTuple hv = reduce_data.value();
+  sums[iq_mass] = amrex::get<iq_mass>(hv);
+  sums[iq_xmom] = amrex::get<iq_xmom>(hv);
+  sums[iq_ymom] = amrex::get<iq_ymom>(hv);
+  sums[iq_zmom] = amrex::get<iq_zmom>(hv);
+  sums[iq_rho_e] = amrex::get<iq_rho_e>(hv);
+  sums[iq_rho_K] = amrex::get<iq_rho_K>(hv);
+  sums[iq_rho_E] = amrex::get<iq_rho_E>(hv);
+  sums[iq_enstrophy] = amrex::get<iq_enstrophy>(hv);
+  sums[iq_fuel_prod] = amrex::get<iq_fuel_prod>(hv);
+  sums[iq_temp] = amrex::get<iq_temp>(hv);
+}
@@ -0,0 +1,56 @@
+#include <algorithm>
+#include <cmath>
+
+#include <AMReX_BLassert.H>
+
+#include "TabulatedProfile.H"
+
+void
+TabulatedProfileData::define(
+  amrex::Vector<amrex::Real>&& x, amrex::Vector<amrex::Real>&& y, int nvar)
+{
+  const int n = x.size();
+  AMREX_ALWAYS_ASSERT(n > 0 && nvar > 0);
+  AMREX_ALWAYS_ASSERT(y.size() == static_cast<std::size_t>(n) * nvar);
+  for (int i = 0; i < n - 1; i++) {
+    if (!(x[i + 1] > x[i])) {
+      amrex::Abort("TabulatedProfileData: abscissae must be increasing");
+    }
+  }
+
+  m_x.resize(n);
+  m_y.resize(y.size());
+  m_yint.resize(y.size());
+  std::copy(x.begin(), x.end(), m_x.begin());
+  std::copy(y.begin(), y.end(), m_y.begin());
+
+  // Running trapezoidal integrals from x[0]
+  for (int j = 0; j < nvar; j++) {
+    const amrex::Real* yj = m_y.data() + j * n;
+    amrex::Real* ij = m_yint.data() + j * n;
+    ij[0] = 0.0;
+    for (int i = 0; i < n - 1; i++) {
+      ij[i + 1] = ij[i] + 0.5 * (x[i + 1] - x[i]) * (yj[i] + yj[i + 1]);
+    }
+  }
+
+  // Use the O(1) lookup when the spacing is uniform to roundoff
+  amrex::Real dxinv = 0.0;
+  if (n > 1) {
+    const amrex::Real h = (x[n - 1] - x[0]) / (n - 1);
+    bool uniform = true;
+    for (int i = 0; i < n - 1 && uniform; i++) {
+      uniform = std::abs((x[i + 1] - x[i]) - h) <= 1.0e-8 * h;
+    }
+    if (uniform) {
+      dxinv = 1.0 / h;
+    }
+  }
+
+  m_view.n = n;
+  m_view.nvar = nvar;
+  m_view.x = m_x.data();
+  m_view.y = m_y.data();
+  m_view.yint = m_yint.data();
+  m_view.dxinv = dxinv;
+}
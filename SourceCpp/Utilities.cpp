@@ -1,12 +1,19 @@
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
 #include "Utilities.H"
 
 AMREX_GPU_DEVICE
-void
+amrex::Real
 pc_cmpTemp(
   const int i, const int j, const int k, amrex::Array4<amrex::Real> const& S)
 {
   amrex::Real rhoInv = 1.0 / S(i, j, k, URHO);
-  amrex::Real T = S(i, j, k, UTEMP);
+  const amrex::Real T0 = S(i, j, k, UTEMP);
+  amrex::Real T = T0;
   amrex::Real e = S(i, j, k, UEINT) * rhoInv;
   amrex::Real massfrac[NUM_SPECIES];
   for (int n = 0; n < NUM_SPECIES; ++n) {
@@ -14,6 +21,7 @@ pc_cmpTemp(
   }
   EOS::EY2T(e, massfrac, T);
   S(i, j, k, UTEMP) = T;
+  return amrex::Math::abs(T - T0) / T;
 }
 
 AMREX_GPU_DEVICE
@@ -163,6 +171,7 @@ pc_rst_int_e(
 // nx    => input resolution
 // ny    => input resolution
 // nz    => input resolution
+// ncol  => number of values per point
 // data  <= output data
 // -----------------------------------------------------------
 void
@@ -180,12 +189,61 @@ read_binary(
     amrex::Abort("Unable to open input file " + iname);
   }
 
-  for (int i = 0; i < nx * ny * nz * ncol; i++) {
-    infile.read(reinterpret_cast<char*>(&data[i]), sizeof(data[i]));
+  // Read everything in one go, the file has no header
+  const size_t n = nx * ny * nz * ncol;
+  infile.read(reinterpret_cast<char*>(data.data()), n * sizeof(double));
+  if (static_cast<size_t>(infile.gcount()) != n * sizeof(double)) {
+    amrex::Abort(
+      "Input file " + iname + " holds less than the " + std::to_string(n) +
+      " values expected from the input resolution");
   }
   infile.close();
 };
 
+// -----------------------------------------------------------
+// Read a contiguous part of a binary file in the read_binary layout
+// INPUTS/OUTPUTS:
+// iname  => filename
+// offset => index of the first value to read
+// data   <= output data, filled with the next data.size() values
+// -----------------------------------------------------------
+void
+read_binary_slab(
+  const std::string iname, const size_t offset, amrex::Vector<double>& data)
+{
+  std::ifstream infile(iname, std::ios::in | std::ios::binary);
+  if (not infile.is_open()) {
+    amrex::Abort("Unable to open input file " + iname);
+  }
+
+  const size_t n = data.size();
+  infile.seekg(offset * sizeof(double));
+  infile.read(reinterpret_cast<char*>(data.data()), n * sizeof(double));
+  if (static_cast<size_t>(infile.gcount()) != n * sizeof(double)) {
+    amrex::Abort(
+      "Input file " + iname + " holds less than the " +
+      std::to_string(offset + n) +
+      " values expected from the input resolution");
+  }
+  infile.close();
+};
+
+// -----------------------------------------------------------
+// Write data as a headerless binary file, in the layout read by
+// read_binary. Returns false if the file could not be written.
+// INPUTS/OUTPUTS:
+// oname => filename
+// data  => data
+// -----------------------------------------------------------
+bool
+write_binary(const std::string oname, const amrex::Vector<double>& data)
+{
+  std::ofstream ofs(oname, std::ios::out | std::ios::binary);
+  ofs.write(
+    reinterpret_cast<const char*>(data.data()), data.size() * sizeof(double));
+  return ofs.good();
+}
+
 // -----------------------------------------------------------
 // Read a csv file
 // INPUTS/OUTPUTS:
@@ -209,37 +267,112 @@ read_csv(
     amrex::Abort("Unable to open input file " + iname);
   }
   infile.close();
-  std::istringstream iss(memfile);
 
-  // Read the file
-  int nlines = 0;
-  std::string firstline, line;
-  std::getline(iss, firstline); // skip header
-  while (getline(iss, line))
-    ++nlines;
+  // Skip the header
+  const char* p = memfile.c_str();
+  const char* end = p + memfile.size();
+  p = std::find(p, end, '\n');
+  p = (p == end) ? end : p + 1;
 
   // Quick sanity check
+  size_t nlines = std::count(p, end, '\n');
+  if (end > p && *(end - 1) != '\n') {
+    ++nlines;
+  }
   if (nlines != nx * ny * nz)
     amrex::Abort(
       "Number of lines in the input file (= " + std::to_string(nlines) +
       ") does not match the input resolution (=" + std::to_string(nx) + ")");
 
-  // Read the data from the file
-  iss.clear();
-  iss.seekg(0, std::ios::beg);
-  std::getline(iss, firstline); // skip header
-  int cnt = 0;
-  while (std::getline(iss, line)) {
-    std::istringstream linestream(line);
-    std::string value;
-    while (getline(linestream, value, ',')) {
-      std::istringstream sinput(value);
-      sinput >> data[cnt];
-      cnt++;
+  // Parse all the values in a single pass over the file
+  size_t cnt = 0;
+  while (p < end) {
+    char* next = nullptr;
+    const double val = std::strtod(p, &next);
+    if (next == p) {
+      // Separator or trailing whitespace
+      ++p;
+      continue;
+    }
+    if (cnt >= data.size()) {
+      amrex::Abort("Too many values in the input file " + iname);
     }
+    data[cnt++] = val;
+    p = next;
+  }
+  if (cnt != data.size()) {
+    amrex::Abort(
+      "Input file " + iname + " holds " + std::to_string(cnt) +
+      " values instead of the " + std::to_string(data.size()) +
+      " expected from the input resolution");
   }
 };
 
+// -----------------------------------------------------------
+// Make a binary copy of the data of a csv file, iname + ".bin", in the
+// layout read by read_binary, and return its name. The csv file is
+// only parsed if the copy is missing, was written from another csv
+// file or reuse is false: the size and modification time of the csv
+// file are stored after the data, and the copy must also be strictly
+// newer than the csv file since modification times only have a
+// resolution of a second.
+// INPUTS/OUTPUTS:
+// iname => filename
+// nx    => input resolution
+// ny    => input resolution
+// nz    => input resolution
+// ncol  => number of values per line
+// reuse => use an up to date copy
+// -----------------------------------------------------------
+std::string
+csv_binary_copy(
+  const std::string iname,
+  const size_t nx,
+  const size_t ny,
+  const size_t nz,
+  const size_t ncol,
+  const bool reuse)
+{
+  const std::string cname = iname + ".bin";
+  const size_t nbytes = nx * ny * nz * ncol * sizeof(double);
+  struct stat istat, cstat;
+  if (stat(iname.c_str(), &istat) != 0) {
+    amrex::Abort("Unable to open input file " + iname);
+  }
+  long long source[2] = {0, 0};
+  const long long current[2] = {
+    static_cast<long long>(istat.st_size),
+    static_cast<long long>(istat.st_mtime)};
+  bool have_copy = reuse && stat(cname.c_str(), &cstat) == 0 &&
+                   cstat.st_mtime > istat.st_mtime &&
+                   static_cast<size_t>(cstat.st_size) ==
+                     nbytes + sizeof(source);
+  if (have_copy) {
+    std::ifstream ifs(cname, std::ios::in | std::ios::binary);
+    ifs.seekg(nbytes);
+    ifs.read(reinterpret_cast<char*>(source), sizeof(source));
+    have_copy =
+      ifs.good() && source[0] == current[0] && source[1] == current[1];
+  }
+  if (have_copy) {
+    return cname;
+  }
+
+  amrex::Vector<double> data(nx * ny * nz * ncol);
+  read_csv(iname, nx, ny, nz, data);
+  bool written = write_binary(cname, data);
+  if (written) {
+    std::ofstream ofs(cname, std::ios::out | std::ios::binary | std::ios::app);
+    ofs.write(reinterpret_cast<const char*>(current), sizeof(current));
+    written = ofs.good();
+  }
+  if (!written) {
+    std::remove(cname.c_str());
+    amrex::Abort("Unable to write the binary copy " + cname);
+  }
+  return cname;
+}
+
 // -----------------------------------------------------------
 // Search for the closest index in an array to a given value
 // using the bisection technique.
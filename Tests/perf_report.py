@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""Performance report of a regression test run at several thread counts
+
+Reads the logs of fixed-step runs of a PeleC regression test built with the
+TinyProfiler, and extracts for each thread count the exclusive time of each
+profiled region, the run time and the throughput in cells*steps/s. The
+report is written as JSON with the scaling against the smallest thread count,
+and compared against a baseline report: the test fails if the throughput or
+the time of a significant region regressed by more than the tolerance.
+Baselines are only written with --update-baseline: without it, a missing
+baseline skips the test.
+"""
+
+# ========================================================================
+#
+# Imports
+#
+# ========================================================================
+import argparse
+import json
+import os
+import re
+import sys
+
+# ========================================================================
+#
+# Some defaults variables
+#
+# ========================================================================
+re_threads = re.compile(r"OMP initialized with (\d+) OMP threads")
+re_ranks = re.compile(r"MPI initialized with (\d+) MPI processes")
+re_cells = re.compile(r"\] Advanced (\d+) cells")
+re_runtime = re.compile(r"^Run time w/o init = ([-+.\deE]+)")
+re_total = re.compile(r"^TinyProfiler total time across processes.*:\s*([-+.\deE]+)")
+re_excl = re.compile(r"^Name\s+NCalls\s+Excl\. Min")
+re_region = re.compile(
+    r"^(\S.*?)\s+(\d+)\s+([-+.\deE]+)\s+([-+.\deE]+)\s+([-+.\deE]+)\s+[.\d]+%$"
+)
+# Exit code of a skipped test, see SKIP_RETURN_CODE in Tests/CMakeLists.txt
+skip_code = 77
+
+
+# ========================================================================
+#
+# Function definitions
+#
+# ========================================================================
+def parse_log(fname):
+    """Timings of one run from its log"""
+    run = {"threads": 1, "ranks": 1, "cells_steps": 0, "run_time": 0.0}
+    phases = {}
+    in_table = False
+    with open(fname, "r") as f:
+        for line in f:
+            line = line.rstrip()
+            m = re_threads.search(line)
+            if m:
+                run["threads"] = int(m.group(1))
+            m = re_ranks.search(line)
+            if m:
+                run["ranks"] = int(m.group(1))
+            m = re_cells.search(line)
+            if m:
+                run["cells_steps"] += int(m.group(1))
+            m = re_runtime.match(line)
+            if m:
+                run["run_time"] = float(m.group(1))
+            m = re_total.match(line)
+            if m:
+                run["profiled_time"] = float(m.group(1))
+
+            # Exclusive times (max over the ranks) of the first table only
+            if re_excl.match(line):
+                in_table = not phases
+                continue
+            if in_table:
+                m = re_region.match(line)
+                if m:
+                    phases[m.group(1)] = float(m.group(5))
+                elif phases and not line.startswith("-"):
+                    in_table = False
+
+    if run["run_time"] <= 0.0:
+        sys.exit(f"{fname}: no run time found, did the run complete?")
+    if not phases:
+        sys.exit(f"{fname}: no TinyProfiler output, build with TINY_PROFILE")
+    run["throughput"] = run["cells_steps"] / run["run_time"]
+    run["phases"] = phases
+    return run
+
+
+def add_scaling(runs):
+    """Speedup and parallel efficiency against the smallest thread count"""
+    counts = sorted(runs, key=int)
+    ref = runs[counts[0]]
+    for n in counts:
+        run = runs[n]
+        run["speedup"] = ref["run_time"] / run["run_time"]
+        run["efficiency"] = run["speedup"] * int(counts[0]) / int(n)
+
+
+def compare(report, baseline, tolerance, min_fraction):
+    """Regressions of the report against the baseline"""
+    failures = []
+    for n, run in sorted(report["runs"].items(), key=lambda x: int(x[0])):
+        if n not in baseline["runs"]:
+            print(f"  {n} threads: not in the baseline")
+            continue
+        base = baseline["runs"][n]
+        ratio = run["throughput"] / base["throughput"]
+        print(f"  {n} threads: throughput {ratio:.3f} of the baseline")
+        if ratio < 1.0 - tolerance:
+            failures.append(f"{n} threads: throughput at {ratio:.3f}")
+
+        # Regions too short to be timed reliably are not checked
+        total = sum(base["phases"].values())
+        for name, tbase in base["phases"].items():
+            if name not in run["phases"] or tbase < min_fraction * total:
+                continue
+            ratio = run["phases"][name] / tbase
+            if ratio > 1.0 + tolerance:
+                failures.append(f"{n} threads: {name} at {ratio:.3f}")
+    return failures
+
+
+def plot_scaling(report, fname):
+    """Run time and efficiency against the thread count"""
+    try:
+        import matplotlib as mpl
+
+        mpl.use("Agg")
+        import matplotlib.pyplot as plt
+    except ImportError:
+        return
+
+    counts = sorted(report["runs"], key=int)
+    threads = [int(n) for n in counts]
+    fig, (ax0, ax1) = plt.subplots(1, 2, figsize=(10, 4))
+    ax0.loglog(
+        threads, [report["runs"][n]["run_time"] for n in counts], "s-", lw=2
+    )
+    ax0.loglog(
+        threads,
+        [report["runs"][counts[0]]["run_time"] * threads[0] / n for n in threads],
+        "k--",
+        lw=1,
+    )
+    ax0.set_xlabel("threads")
+    ax0.set_ylabel("run time (s)")
+    ax1.semilogx(
+        threads, [report["runs"][n]["efficiency"] for n in counts], "s-", lw=2
+    )
+    ax1.set_ylim(0, 1.1)
+    ax1.set_xlabel("threads")
+    ax1.set_ylabel("parallel efficiency")
+    fig.suptitle(report["name"])
+    fig.tight_layout()
+    fig.savefig(fname, dpi=100)
+    plt.close(fig)
+
+
+# ========================================================================
+#
+# Main
+#
+# ========================================================================
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n")[0])
+    parser.add_argument("logs", nargs="+", help="logs of the runs")
+    parser.add_argument("--name", required=True, help="name of the test")
+    parser.add_argument("--baseline", required=True, help="baseline report")
+    parser.add_argument(
+        "--tolerance", type=float, default=0.1, help="allowed relative slowdown"
+    )
+    parser.add_argument(
+        "--min-fraction",
+        type=float,
+        default=0.02,
+        help="smallest fraction of the profiled time of a checked region",
+    )
+    parser.add_argument(
+        "--update-baseline",
+        action="store_true",
+        help="replace the baseline by this report",
+    )
+    args = parser.parse_args()
+
+    report = {"name": args.name, "runs": {}}
+    for fname in args.logs:
+        run = parse_log(fname)
+        report["runs"][str(run["threads"])] = run
+    add_scaling(report["runs"])
+
+    print(f"Performance of {args.name}:")
+    print("  threads  run time (s)  cells*steps/s  speedup  efficiency")
+    for n in sorted(report["runs"], key=int):
+        run = report["runs"][n]
+        print(
+            f"  {int(n):7d}  {run['run_time']:12.4f}  {run['throughput']:13.4e}"
+            f"  {run['speedup']:7.2f}  {run['efficiency']:10.2f}"
+        )
+
+    with open(f"perf-{args.name}.json", "w") as f:
+        json.dump(report, f, indent=2)
+    plot_scaling(report, f"perf-{args.name}-scaling.png")
+
+    if args.update_baseline:
+        os.makedirs(os.path.dirname(os.path.abspath(args.baseline)), exist_ok=True)
+        with open(args.baseline, "w") as f:
+            json.dump(report, f, indent=2)
+        print(f"Baseline written to {args.baseline}")
+        return 0
+
+    if not os.path.isfile(args.baseline):
+        print(f"SKIPPED no baseline {args.baseline}, run with --update-baseline")
+        return skip_code
+
+    with open(args.baseline, "r") as f:
+        baseline = json.load(f)
+    failures = compare(report, baseline, args.tolerance, args.min_fraction)
+    for failure in failures:
+        print(f"REGRESSION {failure}")
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())